@@ -11,6 +11,41 @@ import json
 import sys
 from pathlib import Path
 
+# Fixed-point range for per-LED positions (uint16 across the layout bounds)
+POSITION_FIXED_MAX = 65535
+POSITION_ENTRY_BYTES = 6
+
+
+def validate_geometry(section: dict) -> None:
+    """Validate an optional v2 geometry object on a section."""
+    geometry = section.get("geometry")
+    if geometry is None:
+        return
+
+    section_id = section["id"]
+    geometry_type = geometry.get("type")
+    if geometry_type == "line":
+        points = [geometry.get("start", []), geometry.get("end", [])]
+    elif geometry_type == "path":
+        points = geometry.get("control_points", [])
+        if len(points) < 2:
+            raise ValueError(f"Path for section {section_id} needs at least 2 control_points")
+        interpolation = geometry.get("interpolation", "catmull-rom")
+        if interpolation not in ("linear", "catmull-rom"):
+            raise ValueError(f"Unsupported interpolation for section {section_id}: {interpolation}")
+    elif geometry_type == "point":
+        points = [geometry.get("position", [])]
+    elif geometry_type == "explicit":
+        points = geometry.get("positions", [])
+        if len(points) != section["led_count"]:
+            raise ValueError(f"Explicit positions for section {section_id} ({len(points)}) != led_count")
+    else:
+        raise ValueError(f"Unknown geometry type for section {section_id}: {geometry_type}")
+
+    for point in points:
+        if len(point) != 3 or not all(isinstance(v, (int, float)) for v in point):
+            raise ValueError(f"Invalid point for section {section_id}: {point}")
+
 
 def validate_config(config: dict) -> None:
     """Validate configuration values."""
@@ -31,6 +66,168 @@ def validate_config(config: dict) -> None:
         if len(ip) != 4 or not all(isinstance(b, int) and 0 <= b <= 255 for b in ip):
             raise ValueError(f"Invalid {key}: {ip}")
 
+    # Validate sections fit within their run and have unique, short ids
+    section_ids = set()
+    for run in runs:
+        sections = run.get("sections", [])
+        for section in sections:
+            count = section.get("led_count")
+            if not isinstance(count, int) or isinstance(count, bool) or count <= 0:
+                raise ValueError(f"Invalid led_count for section '{section.get('id', '')}': {count}")
+        section_leds = sum(section["led_count"] for section in sections)
+        if section_leds > run.get("led_count", 0):
+            raise ValueError(f"Sections ({section_leds} LEDs) exceed LED_COUNT for run {run['run_index']}")
+        for section in sections:
+            section_id = section.get("id", "")
+            if not section_id or len(section_id) > 15:
+                raise ValueError(f"Invalid section id: '{section_id}' (1-15 characters)")
+            if section_id in section_ids:
+                raise ValueError(f"Duplicate section id: {section_id}")
+            section_ids.add(section_id)
+            validate_geometry(section)
+
+    # Validate idle timings are non-negative integers (0 disables)
+    for key in ["idle_timeout_ms", "idle_fade_ms"]:
+        value = config.get(key, 0)
+        if not isinstance(value, int) or value < 0:
+            raise ValueError(f"Invalid {key}: {value}")
+
+
+def section_table(runs: list) -> list:
+    """Flatten sections to (id, run, start, count, direction) in physical order.
+
+    Direction is -1 for reversed sections (x1 < x0), which the sender flips,
+    so their x0 end is the last physical LED.
+    """
+    table = []
+    for run in runs:
+        start = 0
+        for section in run.get("sections", []):
+            count = section["led_count"]
+            direction = -1 if section.get("x1", 0) < section.get("x0", 0) else 1
+            table.append((section["id"], run["run_index"], start, count, direction))
+            start += count
+    return table
+
+
+def linear_interpolate(points: list, t: float, closed: bool = False) -> list:
+    # A closed path adds a segment from the last point back to the first
+    if closed:
+        points = points + [points[0]]
+    n = len(points) - 1
+    segment = min(int(t * n), n - 1)
+    local_t = t * n - segment
+    p1, p2 = points[segment], points[segment + 1]
+    return [p1[axis] + (p2[axis] - p1[axis]) * local_t for axis in range(3)]
+
+
+def catmull_rom_interpolate(points: list, t: float, closed: bool = False) -> list:
+    count = len(points)
+    n = count if closed else count - 1
+    segment = min(int(t * n), n - 1)
+    local_t = t * n - segment
+
+    if closed:
+        # Neighbouring control points wrap around the loop
+        p0, p1, p2, p3 = (points[(segment + k) % count] for k in (-1, 0, 1, 2))
+    else:
+        # Clamp neighbouring control points at the ends
+        p0 = points[max(0, segment - 1)]
+        p1 = points[segment]
+        p2 = points[min(n, segment + 1)]
+        p3 = points[min(n, segment + 2)]
+
+    t2 = local_t * local_t
+    t3 = t2 * local_t
+    position = []
+    for axis in range(3):
+        a = -0.5 * p0[axis] + 1.5 * p1[axis] - 1.5 * p2[axis] + 0.5 * p3[axis]
+        b = p0[axis] - 2.5 * p1[axis] + 2 * p2[axis] - 0.5 * p3[axis]
+        c = -0.5 * p0[axis] + 0.5 * p2[axis]
+        d = p1[axis]
+        position.append(a * t3 + b * t2 + c * local_t + d)
+    return position
+
+
+def section_positions(section: dict) -> list:
+    """Compute [x, y, z] per LED along the section, from its x0 end.
+
+    Matches the geometry proposal (docs/proposals/3d-spatial-geometry.md);
+    sections without a geometry object are v1 lines at z = 0.
+    """
+    count = section["led_count"]
+    geometry = section.get("geometry") or {
+        "type": "line",
+        "start": [section.get("x0", 0), section.get("y", 0), 0],
+        "end": [section.get("x1", 0), section.get("y", 0), 0],
+    }
+    geometry_type = geometry["type"]
+
+    if geometry_type == "point":
+        return [list(geometry["position"]) for _ in range(count)]
+    if geometry_type == "explicit":
+        return [list(p) for p in geometry["positions"]]
+
+    if geometry_type == "line":
+        points = [geometry["start"], geometry["end"]]
+        interpolate = linear_interpolate
+        closed = False
+    else:
+        points = geometry["control_points"]
+        closed = geometry.get("closed", False)
+        if geometry.get("interpolation", "catmull-rom") == "linear":
+            interpolate = linear_interpolate
+        else:
+            interpolate = catmull_rom_interpolate
+
+    # A closed loop spaces LEDs evenly without repeating the start point
+    positions = []
+    for i in range(count):
+        if closed:
+            t = i / count
+        else:
+            t = i / (count - 1) if count > 1 else 0
+        positions.append(interpolate(points, t, closed))
+    return positions
+
+
+def position_table(runs: list) -> tuple:
+    """Per-LED positions in physical, run-concatenated order.
+
+    Returns (bounds_min, bounds_max, fixed) where fixed holds (x, y, z)
+    uint16 values across the bounds. Reversed sections are flipped like the
+    sender; LEDs not covered by a section sit at the minimum corner.
+    """
+    world = []
+    for run in runs:
+        run_positions = []
+        for section in run.get("sections", []):
+            positions = section_positions(section)
+            if section.get("x1", 0) < section.get("x0", 0):
+                positions.reverse()
+            run_positions.extend(positions)
+        uncovered = run["led_count"] - len(run_positions)
+        world.extend(run_positions)
+        world.extend([None] * uncovered)
+
+    placed = [p for p in world if p is not None]
+    bounds_min = [min((p[axis] for p in placed), default=0.0) for axis in range(3)]
+    bounds_max = [max((p[axis] for p in placed), default=0.0) for axis in range(3)]
+
+    fixed = []
+    for p in world:
+        if p is None:
+            fixed.append((0, 0, 0))
+            continue
+        entry = []
+        for axis in range(3):
+            span = bounds_max[axis] - bounds_min[axis]
+            value = (p[axis] - bounds_min[axis]) / span if span > 0 else 0.0
+            entry.append(int(round(value * POSITION_FIXED_MAX)))
+        fixed.append(tuple(entry))
+
+    return bounds_min, bounds_max, fixed
+
 
 def generate_header(config: dict) -> str:
     """Generate C++ header content from config."""
@@ -51,10 +248,28 @@ def generate_header(config: dict) -> str:
     static_gateway = config["static_gateway"]
     port_base = config.get("port_base", 49600)
     status_port = config.get("gateway_telemetry_port", 49700)
+    control_port = config.get("control_port", 49800)
+    ddp_port = config.get("ddp_port", 4048)
 
     # Sender IP is the gateway
     sender_ip = static_gateway
 
+    sections = section_table(runs)
+    section_rows = [
+        f'    {{"{sid}", {run}, {start}, {count}, {direction}}},'
+        for sid, run, start, count, direction in sections
+    ]
+
+    bounds_min, bounds_max, positions = position_table(runs)
+    position_rows = [
+        "    " + " ".join(f"{{{x}, {y}, {z}}}," for x, y, z in positions[i:i + 6])
+        for i in range(0, len(positions), 6)
+    ]
+
+    # Idle power-save (0 timeout disables idle, 0 fade holds the last frame)
+    idle_timeout_ms = config.get("idle_timeout_ms", 30000)
+    idle_fade_ms = config.get("idle_fade_ms", 2000)
+
     lines = [
         "// Auto-generated by gen_config.py - DO NOT EDIT",
         "#pragma once",
@@ -69,6 +284,46 @@ def generate_header(config: dict) -> str:
         "// LED counts per run",
         f"constexpr uint16_t LED_COUNT[RUN_COUNT > 0 ? RUN_COUNT : 1] = {{{', '.join(str(c) for c in led_counts)}}};",
         "",
+        "// Sections in physical order (direction -1: x0 end is the last LED)",
+        "struct SectionInfo {",
+        "    const char* id;",
+        "    uint8_t run;",
+        "    uint16_t start;",
+        "    uint16_t count;",
+        "    int8_t direction;",
+        "};",
+        "",
+        f"#define SECTION_COUNT {len(sections)}",
+        "constexpr SectionInfo SECTIONS[SECTION_COUNT > 0 ? SECTION_COUNT : 1] = {",
+        *(section_rows or ['    {"", 0, 0, 0, 1},']),
+        "};",
+        "",
+        "// Per-LED positions in physical order, runs concatenated (same layout as a frame)",
+        "// Fixed point: 0..65535 spans POSITION_MIN..POSITION_MAX on each axis",
+        "struct LedPosition {",
+        "    uint16_t x;",
+        "    uint16_t y;",
+        "    uint16_t z;",
+        "};",
+        "",
+        f"#define POSITION_COUNT {len(positions)}",
+        f"#define POSITION_TABLE_BYTES {len(positions) * POSITION_ENTRY_BYTES}",
+        f"constexpr float POSITION_MIN[3] = {{{', '.join(f'{float(v)!r}f' for v in bounds_min)}}};",
+        f"constexpr float POSITION_MAX[3] = {{{', '.join(f'{float(v)!r}f' for v in bounds_max)}}};",
+        "",
+        "// Table is defined in positions.cpp only, in flash on Teensy 4",
+        "#ifdef POSITION_TABLE_DEFINE",
+        "#if defined(__IMXRT1062__)",
+        "#define POSITION_TABLE_SECTION __attribute__((section(\".progmem\")))",
+        "#else",
+        "#define POSITION_TABLE_SECTION",
+        "#endif",
+        "extern const LedPosition LED_POSITIONS[POSITION_COUNT > 0 ? POSITION_COUNT : 1];",
+        "const LedPosition LED_POSITIONS[POSITION_COUNT > 0 ? POSITION_COUNT : 1] POSITION_TABLE_SECTION = {",
+        *(position_rows or ["    {0, 0, 0},"]),
+        "};",
+        "#endif",
+        "",
         "// Network configuration",
         f"#define STATIC_IP_0 {static_ip[0]}",
         f"#define STATIC_IP_1 {static_ip[1]}",
@@ -92,6 +347,12 @@ def generate_header(config: dict) -> str:
         "",
         f"#define PORT_BASE {port_base}",
         f"#define STATUS_PORT {status_port}",
+        f"#define CONTROL_PORT {control_port}",
+        f"#define DDP_PORT {ddp_port}",
+        "",
+        "// Idle power-save",
+        f"#define IDLE_TIMEOUT_MS {idle_timeout_ms}",
+        f"#define IDLE_FADE_MS {idle_fade_ms}",
         "",
     ]
 
@@ -115,6 +376,11 @@ def main():
     header = generate_header(config)
     print(header)
 
+    # Memory report (stderr, so the header on stdout stays clean)
+    led_total = sum(run["led_count"] for run in config.get("runs", []))
+    print(f"Position table: {led_total} LEDs x {POSITION_ENTRY_BYTES} bytes = "
+          f"{led_total * POSITION_ENTRY_BYTES} bytes flash", file=sys.stderr)
+
 
 if __name__ == "__main__":
     main()
@@ -67,3 +67,7 @@ if result.returncode != 0:
 # Write the generated header
 output_file.write_text(result.stdout)
 print(f"Generated: {output_file.relative_to(project_dir)}")
+
+# Memory report (position table size)
+if result.stderr:
+    print(result.stderr.rstrip())
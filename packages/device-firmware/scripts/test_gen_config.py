@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+Tests for the section and position tables generated by gen_config.py.
+
+Usage:
+    python -m unittest discover -s scripts -p "test_*.py"
+"""
+
+import math
+import unittest
+
+from gen_config import (POSITION_FIXED_MAX, position_table, section_positions, section_table,
+                        validate_geometry)
+
+SQUARE = [[0, 0, 0], [1, 0, 0], [1, 1, 0], [0, 1, 0]]
+
+
+def path(control_points: list, interpolation: str, closed: bool = False) -> dict:
+    return {"type": "path", "control_points": control_points,
+            "interpolation": interpolation, "closed": closed}
+
+
+def positions(geometry: dict, led_count: int) -> list:
+    section = {"id": "s", "led_count": led_count, "geometry": geometry}
+    validate_geometry(section)
+    return section_positions(section)
+
+
+def distance(a: list, b: list) -> float:
+    return math.sqrt(sum((a[axis] - b[axis]) ** 2 for axis in range(3)))
+
+
+class SectionTableTest(unittest.TestCase):
+    def test_forward_and_reversed_sections(self):
+        runs = [
+            {"run_index": 0, "led_count": 10, "sections": [
+                {"id": "a", "led_count": 3, "x0": 0.0, "x1": 1.0},
+                {"id": "b", "led_count": 4, "x0": 2.0, "x1": 1.0},
+                {"id": "c", "led_count": 2, "x0": 2.0, "x1": 3.0},
+            ]},
+            # Start offsets restart in each run
+            {"run_index": 1, "led_count": 5, "sections": [
+                {"id": "d", "led_count": 5, "x0": 3.0, "x1": 0.0},
+            ]},
+        ]
+        self.assertEqual([
+            ("a", 0, 0, 3, 1),
+            ("b", 0, 3, 4, -1),
+            ("c", 0, 7, 2, 1),
+            ("d", 1, 0, 5, -1),
+        ], section_table(runs))
+
+
+class SectionPositionsTest(unittest.TestCase):
+    def assertPointEqual(self, expected: list, actual: list) -> None:
+        for axis in range(3):
+            self.assertAlmostEqual(expected[axis], actual[axis], places=6)
+
+    def test_v1_section_is_a_line_at_z0(self):
+        result = section_positions({"id": "s", "led_count": 5, "x0": 1.0, "x1": 2.0, "y": 0.5})
+        self.assertPointEqual([1.0, 0.5, 0], result[0])
+        self.assertPointEqual([1.5, 0.5, 0], result[2])
+        self.assertPointEqual([2.0, 0.5, 0], result[4])
+
+    def test_line_hits_endpoints(self):
+        result = positions({"type": "line", "start": [0, 0, 0], "end": [4, 2, 1]}, 5)
+        self.assertPointEqual([0, 0, 0], result[0])
+        self.assertPointEqual([4, 2, 1], result[4])
+        self.assertPointEqual([2, 1, 0.5], result[2])
+
+    def test_open_paths_hit_control_points(self):
+        control_points = [[0, 0, 0], [1, 0, 0], [1, 1, 1]]
+        for interpolation in ["linear", "catmull-rom"]:
+            result = positions(path(control_points, interpolation), 5)
+            self.assertPointEqual(control_points[0], result[0])
+            self.assertPointEqual(control_points[1], result[2])
+            self.assertPointEqual(control_points[2], result[4])
+
+    def test_closed_linear_loop_is_evenly_spaced(self):
+        result = positions(path(SQUARE, "linear", closed=True), 8)
+
+        # Corners on even LEDs, edge midpoints on odd ones; no edge repeated
+        for i, corner in enumerate(SQUARE):
+            self.assertPointEqual(corner, result[i * 2])
+        self.assertPointEqual([0, 0.5, 0], result[7])
+
+        # Equal spacing all the way round, including back to the start
+        for i in range(8):
+            self.assertAlmostEqual(0.5, distance(result[i], result[(i + 1) % 8]), places=6)
+
+    def test_closed_catmull_rom_loop_wraps(self):
+        result = positions(path(SQUARE, "catmull-rom", closed=True), 8)
+
+        for i, corner in enumerate(SQUARE):
+            self.assertPointEqual(corner, result[i * 2])
+
+        # The closing edge mirrors the first edge (the square is symmetric about y = x)
+        first, last = result[1], result[7]
+        self.assertPointEqual([first[1], first[0], 0], last)
+
+    def test_point_and_explicit(self):
+        self.assertEqual([[1, 2, 3]] * 3, positions({"type": "point", "position": [1, 2, 3]}, 3))
+
+        explicit = [[0, 0, 0], [5, 1, 0], [2, 2, 2]]
+        self.assertEqual(explicit, positions({"type": "explicit", "positions": explicit}, 3))
+
+        with self.assertRaises(ValueError):
+            positions({"type": "explicit", "positions": explicit}, 4)
+
+    def test_bezier_rejected(self):
+        with self.assertRaises(ValueError):
+            positions(path(SQUARE, "bezier"), 4)
+
+
+class PositionTableTest(unittest.TestCase):
+    def test_reversed_sections_are_in_physical_order(self):
+        runs = [{"run_index": 0, "led_count": 6, "sections": [
+            # Geometry section, reversed: its x0 end is the last physical LED
+            {"id": "a", "led_count": 3, "x0": 2.0, "x1": 1.0,
+             "geometry": {"type": "line", "start": [2, 0, 0], "end": [1, 0, 0]}},
+            # v1 section, reversed
+            {"id": "b", "led_count": 3, "x0": 4.0, "x1": 3.0, "y": 1.0},
+        ]}]
+        bounds_min, bounds_max, fixed = position_table(runs)
+
+        self.assertEqual([1.0, 0, 0], bounds_min)
+        self.assertEqual([4.0, 1.0, 0], bounds_max)
+        x = [entry[0] for entry in fixed]
+        self.assertEqual(sorted(x), x)
+        self.assertEqual(0, x[0])
+        self.assertEqual(POSITION_FIXED_MAX, x[5])
+
+    def test_uncovered_leds_at_origin(self):
+        runs = [{"run_index": 0, "led_count": 4, "sections": [
+            {"id": "a", "led_count": 2, "x0": 1.0, "x1": 2.0, "y": 1.0},
+        ]}]
+        _, _, fixed = position_table(runs)
+
+        self.assertEqual(4, len(fixed))
+        self.assertEqual([(0, 0, 0), (POSITION_FIXED_MAX, 0, 0), (0, 0, 0), (0, 0, 0)], fixed)
+
+
+if __name__ == "__main__":
+    unittest.main()
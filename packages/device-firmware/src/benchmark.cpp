@@ -0,0 +1,181 @@
+#include "benchmark.h"
+#include "config_autogen.h"
+#include "idle.h"
+#include "led_driver.h"
+#include "network.h"
+#include "receiver.h"
+#include "status.h"
+#include "hal/hal.h"
+#include <cstdio>
+
+// Packet header size (matches receiver.cpp)
+static const size_t HEADER_SIZE = 6;
+
+// Session used for synthetic packets (live session is restored afterwards)
+static const uint16_t BENCHMARK_SESSION_ID = 0xBE0C;
+
+static uint8_t packet_buffer[HEADER_SIZE + MAX_LEDS * 3];
+static char heartbeat_buffer[512];
+static char json_buffer[512];
+
+static bool pending = false;
+static uint16_t pending_iterations = 0;
+
+// Accumulates per-iteration cycle counts for one stage
+struct StageAccumulator {
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+};
+
+static void stage_add(StageAccumulator& acc, uint32_t cycles) {
+    if (cycles < acc.min) {
+        acc.min = cycles;
+    }
+    if (cycles > acc.max) {
+        acc.max = cycles;
+    }
+    acc.total += cycles;
+}
+
+static BenchmarkStage stage_result(const StageAccumulator& acc, uint16_t iterations) {
+    BenchmarkStage stage;
+    stage.min = acc.min;
+    stage.avg = (uint32_t)(acc.total / iterations);
+    stage.max = acc.max;
+    return stage;
+}
+
+static void build_packet(uint32_t frame_id, int run_index) {
+    packet_buffer[0] = (BENCHMARK_SESSION_ID >> 8) & 0xFF;
+    packet_buffer[1] = BENCHMARK_SESSION_ID & 0xFF;
+    packet_buffer[2] = (frame_id >> 24) & 0xFF;
+    packet_buffer[3] = (frame_id >> 16) & 0xFF;
+    packet_buffer[4] = (frame_id >> 8) & 0xFF;
+    packet_buffer[5] = frame_id & 0xFF;
+
+    // Vary the payload so nothing can be cached between iterations
+    uint8_t seed = (uint8_t)(frame_id + run_index);
+    for (int i = 0; i < LED_COUNT[run_index] * 3; i++) {
+        packet_buffer[HEADER_SIZE + i] = (uint8_t)(seed + i);
+    }
+}
+
+BenchmarkResults benchmark_run(uint16_t iterations) {
+    if (iterations == 0) {
+        iterations = BENCHMARK_DEFAULT_ITERATIONS;
+    }
+    if (iterations > BENCHMARK_MAX_ITERATIONS) {
+        iterations = BENCHMARK_MAX_ITERATIONS;
+    }
+
+    ReceiverCheckpoint checkpoint = receiver_checkpoint();
+
+    StageAccumulator ingest = {UINT32_MAX, 0, 0};
+    StageAccumulator encode = {UINT32_MAX, 0, 0};
+    StageAccumulator heartbeat = {UINT32_MAX, 0, 0};
+
+    ReceiverStats heartbeat_stats = {59, 55, 54, 1, 1};
+
+    // Warm-up frame absorbs the one-off session change
+    for (int run = 0; run < RUN_COUNT; run++) {
+        build_packet(0, run);
+        receiver_handle_packet(run, packet_buffer, HEADER_SIZE + LED_COUNT[run] * 3);
+    }
+    receiver_get_complete_frame();
+
+    for (uint16_t i = 0; i < iterations; i++) {
+        uint32_t frame_id = i + 1;
+
+        // Ingest: packet building is excluded, only receiver work is timed
+        uint32_t cycles = 0;
+        for (int run = 0; run < RUN_COUNT; run++) {
+            build_packet(frame_id, run);
+            uint32_t start = hal::cycle_count();
+            receiver_handle_packet(run, packet_buffer, HEADER_SIZE + LED_COUNT[run] * 3);
+            cycles += hal::cycle_count() - start;
+        }
+        uint32_t start = hal::cycle_count();
+        const uint8_t* frame = receiver_get_complete_frame();
+        cycles += hal::cycle_count() - start;
+        stage_add(ingest, cycles);
+
+        // Encode into the LED buffer without starting output
+        if (frame != nullptr) {
+            start = hal::cycle_count();
+            driver_encode_frame(frame);
+            stage_add(encode, hal::cycle_count() - start);
+        }
+
+        start = hal::cycle_count();
+        status_build_heartbeat(heartbeat_buffer, sizeof(heartbeat_buffer),
+                               heartbeat_stats, nullptr);
+        stage_add(heartbeat, hal::cycle_count() - start);
+    }
+
+    receiver_restore(checkpoint);
+
+    BenchmarkResults results;
+    results.iterations = iterations;
+    results.cycle_hz = hal::cycle_count_hz();
+    results.ingest = stage_result(ingest, iterations);
+    results.encode = stage_result(encode, iterations);
+    results.heartbeat = stage_result(heartbeat, iterations);
+    return results;
+}
+
+static int format_stage(char* buffer, size_t size, const char* name,
+                        const BenchmarkStage& stage) {
+    return snprintf(buffer, size, ",\"%s\":{\"min\":%lu,\"avg\":%lu,\"max\":%lu}",
+                    name,
+                    (unsigned long)stage.min,
+                    (unsigned long)stage.avg,
+                    (unsigned long)stage.max);
+}
+
+int benchmark_format_json(const BenchmarkResults& results, char* buffer, size_t size) {
+    int total_leds = 0;
+    for (int i = 0; i < RUN_COUNT; i++) {
+        total_leds += LED_COUNT[i];
+    }
+
+    // Format: {"type":"benchmark","id":"LEFT","build":"...","ingest":{...},...}
+    int pos = snprintf(buffer, size,
+                       "{\"type\":\"benchmark\",\"id\":\"%s\",\"build\":\"%s %s\",\"runs\":%d,\"leds\":%d,\"iterations\":%u,\"cycle_hz\":%lu",
+                       SIDE_ID, __DATE__, __TIME__,
+                       RUN_COUNT,
+                       total_leds,
+                       (unsigned)results.iterations,
+                       (unsigned long)results.cycle_hz);
+
+    pos += format_stage(buffer + pos, size - pos, "ingest", results.ingest);
+    pos += format_stage(buffer + pos, size - pos, "encode", results.encode);
+    pos += format_stage(buffer + pos, size - pos, "heartbeat", results.heartbeat);
+    pos += snprintf(buffer + pos, size - pos, "}");
+
+    return pos;
+}
+
+void benchmark_request(uint16_t iterations) {
+    pending = true;
+    pending_iterations = iterations;
+}
+
+void benchmark_poll() {
+    if (!pending) {
+        return;
+    }
+
+    // Wait for the current frame to finish transmitting
+    if (driver_is_busy()) {
+        return;
+    }
+    pending = false;
+
+    // Always measure at full clock, even if requested while asleep
+    idle_restore_clock();
+
+    BenchmarkResults results = benchmark_run(pending_iterations);
+    int len = benchmark_format_json(results, json_buffer, sizeof(json_buffer));
+    network_send_control_reply(json_buffer, len);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Cycle counts for one benchmark stage, per iteration
+struct BenchmarkStage {
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+};
+
+struct BenchmarkResults {
+    uint16_t iterations;
+    uint32_t cycle_hz;          // Cycle counter rate (CPU clock on target, 1GHz ns on native)
+    BenchmarkStage ingest;      // Synthetic packets for all runs -> complete frame
+    BenchmarkStage encode;      // Complete frame -> LED buffer (no output)
+    BenchmarkStage heartbeat;   // Heartbeat JSON build
+};
+
+static const uint16_t BENCHMARK_DEFAULT_ITERATIONS = 100;
+static const uint16_t BENCHMARK_MAX_ITERATIONS = 1000;
+
+// Run the benchmark synchronously against the live receiver, driver and
+// status code; receiver state is checkpointed and restored around it
+BenchmarkResults benchmark_run(uint16_t iterations);
+
+// Format results as a JSON datagram, returns length written
+int benchmark_format_json(const BenchmarkResults& results, char* buffer, size_t size);
+
+// Queue a benchmark (0 iterations selects the default)
+void benchmark_request(uint16_t iterations);
+
+// Run a queued benchmark between frames and send the results to the requester
+void benchmark_poll();
@@ -0,0 +1,178 @@
+#include "calibration.h"
+#include "config_autogen.h"
+#include "led_driver.h"
+#include "idle.h"
+#include "hal/hal.h"
+#include <cstring>
+
+// Warm white at 50% brightness (matches wakeup)
+static const uint8_t WARM_WHITE_RED = 128;
+static const uint8_t WARM_WHITE_GREEN = 100;
+static const uint8_t WARM_WHITE_BLUE = 64;
+
+// Dim level for the rest of the section during a chase
+static const uint8_t CHASE_BACKGROUND = 8;
+static const int CHASE_LENGTH = 5;
+
+// Timing constants
+static const uint32_t FRAME_INTERVAL_MS = 20;
+static const uint32_t IDENTIFY_BLINK_MS = 250;
+static const uint32_t CHASE_PERIOD_MS = 2000;
+
+// Patterns stop on their own if the requester goes away
+static const uint32_t PATTERN_TIMEOUT_MS = 60000;
+
+static const int NUM_STRIPS = 8;
+
+static CalibrationPattern current_pattern = CalibrationPattern::OFF;
+static int current_section = -1;
+static uint32_t pattern_start_ms = 0;
+static uint32_t last_render_ms = 0;
+
+// Position of a physical LED along the section, 0 at the x0 end, 255 at the x1 end
+static uint8_t position_from_x0(const SectionInfo& section, int offset) {
+    if (section.count <= 1) {
+        return 0;
+    }
+    uint32_t t = (uint32_t)offset * 255 / (section.count - 1);
+    return (uint8_t)(section.direction < 0 ? 255 - t : t);
+}
+
+static void clear_all_strips() {
+    for (int strip = 0; strip < NUM_STRIPS; strip++) {
+        for (int i = 0; i < MAX_LEDS; i++) {
+            hal::leds_set_pixel(strip, i, 0, 0, 0);
+        }
+    }
+}
+
+static void render_identify(const SectionInfo& section, uint32_t elapsed) {
+    if ((elapsed / IDENTIFY_BLINK_MS) % 2 != 0) {
+        return;
+    }
+    for (int i = 0; i < section.count; i++) {
+        hal::leds_set_pixel(section.run, section.start + i,
+                            WARM_WHITE_RED, WARM_WHITE_GREEN, WARM_WHITE_BLUE);
+    }
+}
+
+static void render_chase(const SectionInfo& section, uint32_t elapsed) {
+    // Head position measured from the x0 end
+    int head = (int)((elapsed % CHASE_PERIOD_MS) * section.count / CHASE_PERIOD_MS);
+
+    for (int i = 0; i < section.count; i++) {
+        int from_x0 = section.direction < 0 ? section.count - 1 - i : i;
+        uint8_t level = (from_x0 <= head && from_x0 > head - CHASE_LENGTH) ? 255 : CHASE_BACKGROUND;
+        hal::leds_set_pixel(section.run, section.start + i, level, level, level);
+    }
+}
+
+static void render_gradient(const SectionInfo& section) {
+    for (int i = 0; i < section.count; i++) {
+        uint8_t t = position_from_x0(section, i);
+        hal::leds_set_pixel(section.run, section.start + i, 255 - t, 0, t);
+    }
+}
+
+static void render(uint32_t elapsed) {
+    const SectionInfo& section = SECTIONS[current_section];
+
+    clear_all_strips();
+
+    switch (current_pattern) {
+        case CalibrationPattern::IDENTIFY:
+            render_identify(section, elapsed);
+            break;
+
+        case CalibrationPattern::CHASE:
+            render_chase(section, elapsed);
+            break;
+
+        case CalibrationPattern::GRADIENT:
+            render_gradient(section);
+            break;
+
+        case CalibrationPattern::OFF:
+            break;
+    }
+
+    hal::leds_show();
+    idle_frame_displayed();
+}
+
+void calibration_init() {
+    current_pattern = CalibrationPattern::OFF;
+    current_section = -1;
+    pattern_start_ms = 0;
+    last_render_ms = 0;
+}
+
+int calibration_find_section(const char* section_id) {
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        if (strcmp(SECTIONS[i].id, section_id) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool calibration_start(CalibrationPattern pattern, const char* section_id) {
+    if (pattern == CalibrationPattern::OFF) {
+        calibration_stop();
+        return true;
+    }
+
+    if (pattern > CalibrationPattern::GRADIENT) {
+        return false;
+    }
+
+    int section = calibration_find_section(section_id);
+    if (section < 0) {
+        return false;
+    }
+
+    current_pattern = pattern;
+    current_section = section;
+    pattern_start_ms = hal::millis();
+
+    // Render on the next poll
+    last_render_ms = pattern_start_ms - FRAME_INTERVAL_MS;
+    return true;
+}
+
+void calibration_stop() {
+    if (current_pattern == CalibrationPattern::OFF) {
+        return;
+    }
+    current_pattern = CalibrationPattern::OFF;
+    current_section = -1;
+    driver_show_black();
+}
+
+bool calibration_is_active() {
+    return current_pattern != CalibrationPattern::OFF;
+}
+
+void calibration_poll() {
+    if (current_pattern == CalibrationPattern::OFF) {
+        return;
+    }
+
+    // Check if LEDs are busy - don't redraw while DMA is active
+    if (hal::leds_busy()) {
+        return;
+    }
+
+    uint32_t now = hal::millis();
+    uint32_t elapsed = now - pattern_start_ms;
+
+    if (elapsed >= PATTERN_TIMEOUT_MS) {
+        calibration_stop();
+        return;
+    }
+
+    if (now - last_render_ms >= FRAME_INTERVAL_MS) {
+        last_render_ms = now;
+        render(elapsed);
+    }
+}
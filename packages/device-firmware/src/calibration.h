@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// On-device calibration patterns, rendered for one section in place of the
+// stream (requested via the control port, no pixel streaming needed)
+enum class CalibrationPattern : uint8_t {
+    OFF = 0,        // Return to the stream
+    IDENTIFY = 1,   // Section blinks warm white
+    CHASE = 2,      // Bright segment travels from the x0 end to the x1 end
+    GRADIENT = 3    // Red at the x0 end fading to blue at the x1 end
+};
+
+// Initialize calibration state (no pattern active)
+void calibration_init();
+
+// Start a pattern on the section with this id, or stop with OFF
+// Returns false if the pattern or section id is unknown
+bool calibration_start(CalibrationPattern pattern, const char* section_id);
+
+// Stop any pattern and blank the LEDs until the next streamed frame
+void calibration_stop();
+
+// Check if a pattern is active (stream frames are not displayed)
+bool calibration_is_active();
+
+// Poll the pattern renderer
+// Call from main loop - redraws when DMA is idle, stops after a timeout
+void calibration_poll();
+
+// Find a section index by id, -1 if not found
+int calibration_find_section(const char* section_id);
@@ -0,0 +1,82 @@
+#include "control.h"
+#include "benchmark.h"
+#include "calibration.h"
+#include "config_autogen.h"
+#include "idle.h"
+#include "network.h"
+#include <cstdio>
+#include <cstring>
+
+// Packet layout: u8 command, then command-specific payload
+static const size_t COMMAND_OFFSET = 0;
+static const size_t PAYLOAD_OFFSET = 1;
+
+// Longest section id accepted by gen_config.py
+static const size_t MAX_SECTION_ID_LEN = 15;
+
+static char reply_buffer[128];
+
+// Parse big-endian uint16
+static uint16_t read_u16_be(const uint8_t* data) {
+    return (data[0] << 8) | data[1];
+}
+
+static void handle_benchmark(const uint8_t* payload, size_t len) {
+    // Optional u16 BE iteration count
+    uint16_t iterations = len >= 2 ? read_u16_be(payload) : 0;
+    benchmark_request(iterations);
+}
+
+static void handle_pattern(const uint8_t* payload, size_t len) {
+    // u8 pattern, then the section id as ASCII (no terminator)
+    if (len < 1) {
+        return;
+    }
+
+    uint8_t pattern = payload[0];
+    char section_id[MAX_SECTION_ID_LEN + 1] = {0};
+    size_t id_len = len - 1;
+    if (id_len > MAX_SECTION_ID_LEN) {
+        id_len = MAX_SECTION_ID_LEN;
+    }
+    memcpy(section_id, payload + 1, id_len);
+
+    bool ok = calibration_start((CalibrationPattern)pattern, section_id);
+
+    // Patterns are rendered at full clock; rejected commands and off don't wake
+    if (ok && pattern != (uint8_t)CalibrationPattern::OFF) {
+        idle_note_activity();
+    }
+
+    // Only echo ids that matched the generated table (safe to embed in JSON)
+    int section = ok ? calibration_find_section(section_id) : -1;
+    int reply_len = snprintf(reply_buffer, sizeof(reply_buffer),
+                             "{\"type\":\"pattern\",\"pattern\":%u,\"section\":\"%s\",\"ok\":%s}",
+                             (unsigned)pattern,
+                             section >= 0 ? SECTIONS[section].id : "",
+                             ok ? "true" : "false");
+    network_send_control_reply(reply_buffer, reply_len);
+}
+
+void control_handle_packet(const uint8_t* data, size_t len) {
+    if (len < PAYLOAD_OFFSET) {
+        return;
+    }
+
+    const uint8_t* payload = data + PAYLOAD_OFFSET;
+    size_t payload_len = len - PAYLOAD_OFFSET;
+
+    switch (data[COMMAND_OFFSET]) {
+        case CONTROL_CMD_BENCHMARK:
+            handle_benchmark(payload, payload_len);
+            break;
+
+        case CONTROL_CMD_PATTERN:
+            handle_pattern(payload, payload_len);
+            break;
+
+        default:
+            // Unknown commands are ignored
+            break;
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Control command IDs (first byte of a control packet)
+static const uint8_t CONTROL_CMD_BENCHMARK = 0x01;
+static const uint8_t CONTROL_CMD_PATTERN = 0x02;
+
+// Handle an incoming control packet from CONTROL_PORT
+void control_handle_packet(const uint8_t* data, size_t len);
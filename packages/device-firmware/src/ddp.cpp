@@ -0,0 +1,83 @@
+#include "ddp.h"
+#include "idle.h"
+#include "receiver.h"
+
+// DDP header layout (all multi-byte fields big-endian)
+// 0: flags  (VV T S R Q P: version, timecode, storage, reply, query, push)
+// 1: sequence (low 4 bits)
+// 2: data type
+// 3: destination id
+// 4: data offset in bytes (u32)
+// 8: data length in bytes (u16)
+// 10: timecode (u32, only if T flag set)
+static const size_t HEADER_SIZE = 10;
+static const size_t TIMECODE_SIZE = 4;
+
+static const uint8_t FLAG_VERSION_MASK = 0xC0;
+static const uint8_t FLAG_VERSION_1 = 0x40;
+static const uint8_t FLAG_TIMECODE = 0x10;
+static const uint8_t FLAG_QUERY = 0x02;
+static const uint8_t FLAG_PUSH = 0x01;
+
+// Data type: TTT (bits 5-3) = 0 undefined, 1 RGB; SSS (bits 2-0) = 0 undefined, 3 8-bit
+static const uint8_t TYPE_RGB = 1;
+static const uint8_t SIZE_8BIT = 3;
+
+// Older senders put the RGB type in the low bits (0x01) with no size field
+static const uint8_t DATA_TYPE_LEGACY_RGB = 0x01;
+
+// Destination ids that address the display buffer
+static const uint8_t ID_DISPLAY = 1;
+static const uint8_t ID_ALL = 255;
+
+// Parse big-endian uint16
+static uint16_t read_u16_be(const uint8_t* data) {
+    return (data[0] << 8) | data[1];
+}
+
+// Parse big-endian uint32
+static uint32_t read_u32_be(const uint8_t* data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+           ((uint32_t)data[2] << 8) | data[3];
+}
+
+static bool is_rgb8(uint8_t data_type) {
+    if (data_type == DATA_TYPE_LEGACY_RGB) {
+        return true;
+    }
+
+    uint8_t type = (data_type >> 3) & 0x07;
+    uint8_t size = data_type & 0x07;
+    return (type == 0 || type == TYPE_RGB) && (size == 0 || size == SIZE_8BIT);
+}
+
+void ddp_handle_packet(const uint8_t* data, size_t len) {
+    // Malformed and unsupported packets are ignored
+    if (len < HEADER_SIZE) {
+        return;
+    }
+
+    uint8_t flags = data[0];
+    uint8_t data_type = data[2];
+    uint8_t destination = data[3];
+
+    // Queries, non-display destinations and non-RGB data are not supported
+    if ((flags & FLAG_VERSION_MASK) != FLAG_VERSION_1 || (flags & FLAG_QUERY) ||
+        (destination != ID_DISPLAY && destination != ID_ALL) || !is_rgb8(data_type)) {
+        return;
+    }
+
+    size_t header_size = HEADER_SIZE + ((flags & FLAG_TIMECODE) ? TIMECODE_SIZE : 0);
+    uint32_t offset = read_u32_be(data + 4);
+    uint16_t data_len = read_u16_be(data + 8);
+
+    if (len < header_size + data_len) {
+        return;
+    }
+
+    // Only accepted packets wake from idle; queries and discovery from DDP
+    // tools on the network leave the controller asleep
+    idle_note_activity();
+
+    receiver_handle_ddp(offset, data + header_size, data_len, (flags & FLAG_PUSH) != 0);
+}
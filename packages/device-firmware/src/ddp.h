@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Handle an incoming DDP (Distributed Display Protocol) packet from DDP_PORT
+// RGB data is written at the packet's byte offset into the frame; the PUSH
+// flag marks the frame complete for synchronised display
+void ddp_handle_packet(const uint8_t* data, size_t len);
@@ -6,6 +6,11 @@
 namespace hal {
     // Time
     uint32_t millis();
+    uint32_t micros();
+
+    // Cycle counter (DWT on target), and its rate for converting to time
+    uint32_t cycle_count();
+    uint32_t cycle_count_hz();
     void delay_ms(uint32_t ms);
     void delay_us(uint32_t us);
 
@@ -19,12 +24,26 @@ namespace hal {
     void network_poll(PacketCallback cb);
     void network_send_udp(const char* json, size_t len);
 
+    // Datagram callback for sockets not tied to a run
+    using DatagramCallback = void(*)(const uint8_t* data, size_t len);
+
+    // Control datagrams on CONTROL_PORT; replies go to the last sender
+    void network_poll_control(DatagramCallback cb);
+    void network_send_control_reply(const char* json, size_t len);
+
+    // DDP datagrams on DDP_PORT
+    void network_poll_ddp(DatagramCallback cb);
+
     // LED output
     void leds_init(int max_leds_per_strip);
     void leds_set_pixel(int strip, int index, uint8_t r, uint8_t g, uint8_t b);
     void leds_show();
     bool leds_busy();
 
+    // Power management
+    void cpu_set_low_power(bool low);
+    void wait_for_interrupt();
+
     // Status LED
     void status_led_init();
     void status_led_set(bool on);
@@ -46,6 +65,8 @@ namespace hal::test {
 
     // Packet injection
     void inject_packet(uint8_t run_index, const uint8_t* data, size_t len);
+    void inject_control_packet(const uint8_t* data, size_t len);
+    void inject_ddp_packet(const uint8_t* data, size_t len);
 
     // LED state capture
     struct LedState { uint8_t r, g, b; };
@@ -55,9 +76,19 @@ namespace hal::test {
     // Heartbeat capture
     const std::vector<std::string>& get_sent_heartbeats();
 
+    // Control reply capture
+    const std::vector<std::string>& get_sent_control_replies();
+
     // Status LED state
     bool get_status_led();
 
+    // Power state capture
+    bool get_cpu_low_power();
+    int get_wait_count();
+
+    // Simulated time taken by a clock switch (default 0)
+    void set_clock_switch_ms(uint32_t ms);
+
     // Reset all state
     void reset();
 }
@@ -5,6 +5,7 @@
 #include <string>
 #include <queue>
 #include <cstring>
+#include <chrono>
 
 // Simulated state
 static uint32_t simulated_time_ms = 0;
@@ -12,6 +13,11 @@ static bool link_up = true;
 static char ip_string[] = "10.10.0.3";
 static bool status_led_state = false;
 
+// Power state
+static bool cpu_low_power = false;
+static int wait_count = 0;
+static uint32_t clock_switch_ms = 0;
+
 // LED state
 static int max_leds = 0;
 static const int NUM_STRIPS = 8;
@@ -24,10 +30,15 @@ struct InjectedPacket {
     std::vector<uint8_t> data;
 };
 static std::queue<InjectedPacket> packet_queue;
+static std::queue<std::vector<uint8_t>> control_queue;
+static std::queue<std::vector<uint8_t>> ddp_queue;
 
 // Heartbeat capture
 static std::vector<std::string> sent_heartbeats;
 
+// Control reply capture
+static std::vector<std::string> sent_control_replies;
+
 namespace hal {
 
 // Time functions
@@ -35,6 +46,20 @@ uint32_t millis() {
     return simulated_time_ms;
 }
 
+uint32_t micros() {
+    return simulated_time_ms * 1000;
+}
+
+uint32_t cycle_count() {
+    // Host has no portable cycle counter; count real nanoseconds instead
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+uint32_t cycle_count_hz() {
+    return 1000000000;
+}
+
 void delay_ms(uint32_t ms) {
     simulated_time_ms += ms;
 }
@@ -72,6 +97,26 @@ void network_send_udp(const char* json, size_t len) {
     sent_heartbeats.emplace_back(json, len);
 }
 
+void network_poll_control(DatagramCallback cb) {
+    while (!control_queue.empty() && cb != nullptr) {
+        std::vector<uint8_t>& pkt = control_queue.front();
+        cb(pkt.data(), pkt.size());
+        control_queue.pop();
+    }
+}
+
+void network_send_control_reply(const char* json, size_t len) {
+    sent_control_replies.emplace_back(json, len);
+}
+
+void network_poll_ddp(DatagramCallback cb) {
+    while (!ddp_queue.empty() && cb != nullptr) {
+        std::vector<uint8_t>& pkt = ddp_queue.front();
+        cb(pkt.data(), pkt.size());
+        ddp_queue.pop();
+    }
+}
+
 // LED functions
 void leds_init(int max_leds_per_strip) {
     max_leds = max_leds_per_strip;
@@ -97,6 +142,21 @@ bool leds_busy() {
     return false;
 }
 
+// Power management functions
+void cpu_set_low_power(bool low) {
+    // Simulate the PLL relock time of a clock switch
+    if (low != cpu_low_power) {
+        simulated_time_ms += clock_switch_ms;
+    }
+    cpu_low_power = low;
+}
+
+void wait_for_interrupt() {
+    // Simulate the 1ms tick that would wake the core
+    wait_count++;
+    simulated_time_ms += 1;
+}
+
 // Status LED functions
 void status_led_init() {
     status_led_state = false;
@@ -130,6 +190,14 @@ void inject_packet(uint8_t run_index, const uint8_t* data, size_t len) {
     packet_queue.push(std::move(pkt));
 }
 
+void inject_control_packet(const uint8_t* data, size_t len) {
+    control_queue.emplace(data, data + len);
+}
+
+void inject_ddp_packet(const uint8_t* data, size_t len) {
+    ddp_queue.emplace(data, data + len);
+}
+
 const LedState& get_led(int strip, int index) {
     static LedState black = {0, 0, 0};
     if (strip < 0 || strip >= NUM_STRIPS || index < 0 || index >= max_leds) {
@@ -146,15 +214,34 @@ const std::vector<std::string>& get_sent_heartbeats() {
     return sent_heartbeats;
 }
 
+const std::vector<std::string>& get_sent_control_replies() {
+    return sent_control_replies;
+}
+
 bool get_status_led() {
     return status_led_state;
 }
 
+bool get_cpu_low_power() {
+    return cpu_low_power;
+}
+
+int get_wait_count() {
+    return wait_count;
+}
+
+void set_clock_switch_ms(uint32_t ms) {
+    clock_switch_ms = ms;
+}
+
 void reset() {
     simulated_time_ms = 0;
     link_up = true;
     status_led_state = false;
     show_count = 0;
+    cpu_low_power = false;
+    wait_count = 0;
+    clock_switch_ms = 0;
 
     // Clear LED buffer
     for (auto& led : led_buffer) {
@@ -166,8 +253,17 @@ void reset() {
         packet_queue.pop();
     }
 
-    // Clear heartbeat capture
+    // Clear control and DDP queues
+    while (!control_queue.empty()) {
+        control_queue.pop();
+    }
+    while (!ddp_queue.empty()) {
+        ddp_queue.pop();
+    }
+
+    // Clear heartbeat and control reply capture
     sent_heartbeats.clear();
+    sent_control_replies.clear();
 }
 
 } // namespace hal::test
@@ -8,6 +8,9 @@
 
 using namespace qindesign::network;
 
+// Teensy core clock control (defined in clockspeed.c)
+extern "C" uint32_t set_arm_clock(uint32_t frequency);
+
 // OctoWS2811 configuration
 static const int NUM_STRIPS = 8;
 static int leds_per_strip = 0;
@@ -20,6 +23,8 @@ static OctoWS2811* leds = nullptr;
 // Network configuration
 static EthernetUDP udp_sockets[RUN_COUNT > 0 ? RUN_COUNT : 1];
 static EthernetUDP status_socket;
+static EthernetUDP control_socket;
+static EthernetUDP ddp_socket;
 
 static IPAddress static_ip(STATIC_IP_0, STATIC_IP_1, STATIC_IP_2, STATIC_IP_3);
 static IPAddress netmask(STATIC_NETMASK_0, STATIC_NETMASK_1, STATIC_NETMASK_2, STATIC_NETMASK_3);
@@ -32,6 +37,11 @@ static uint8_t packet_buffer[2048];
 // Status LED
 static const int STATUS_LED_PIN = 13;
 
+// Idle clock. The Ethernet PHY clock and the 1ms SysTick (100kHz reference)
+// are independent of the ARM clock, so networking and millis() keep working.
+// OctoWS2811 timing is derived from the bus clock: never show() while low.
+static const uint32_t IDLE_CPU_HZ = 24000000;
+
 namespace hal {
 
 // Time functions
@@ -39,6 +49,19 @@ uint32_t millis() {
     return ::millis();
 }
 
+uint32_t micros() {
+    return ::micros();
+}
+
+uint32_t cycle_count() {
+    // DWT cycle counter is enabled by the Teensy core at startup
+    return ARM_DWT_CYCCNT;
+}
+
+uint32_t cycle_count_hz() {
+    return F_CPU_ACTUAL;
+}
+
 void delay_ms(uint32_t ms) {
     ::delay(ms);
 }
@@ -63,6 +86,12 @@ void network_init() {
 
     // Status socket for sending heartbeats
     status_socket.begin(0);
+
+    // Control socket for commands (replies go back to the requester)
+    control_socket.begin(CONTROL_PORT);
+
+    // DDP socket for third-party renderers
+    ddp_socket.begin(DDP_PORT);
 }
 
 bool network_link_up() {
@@ -98,6 +127,41 @@ void network_send_udp(const char* json, size_t len) {
     status_socket.endPacket();
 }
 
+void network_poll_control(DatagramCallback cb) {
+    int packet_size = control_socket.parsePacket();
+
+    while (packet_size > 0) {
+        int len = control_socket.read(packet_buffer, sizeof(packet_buffer));
+
+        if (len > 0 && cb != nullptr) {
+            cb(packet_buffer, len);
+        }
+
+        packet_size = control_socket.parsePacket();
+    }
+}
+
+void network_send_control_reply(const char* json, size_t len) {
+    // remoteIP()/remotePort() refer to the last packet parsed on this socket
+    control_socket.beginPacket(control_socket.remoteIP(), control_socket.remotePort());
+    control_socket.write((const uint8_t*)json, len);
+    control_socket.endPacket();
+}
+
+void network_poll_ddp(DatagramCallback cb) {
+    int packet_size = ddp_socket.parsePacket();
+
+    while (packet_size > 0) {
+        int len = ddp_socket.read(packet_buffer, sizeof(packet_buffer));
+
+        if (len > 0 && cb != nullptr) {
+            cb(packet_buffer, len);
+        }
+
+        packet_size = ddp_socket.parsePacket();
+    }
+}
+
 // LED functions
 void leds_init(int max_leds_per_strip) {
     leds_per_strip = max_leds_per_strip;
@@ -135,6 +199,16 @@ bool leds_busy() {
     return leds != nullptr ? leds->busy() : false;
 }
 
+// Power management functions
+void cpu_set_low_power(bool low) {
+    set_arm_clock(low ? IDLE_CPU_HZ : F_CPU);
+}
+
+void wait_for_interrupt() {
+    // Sleep the core until the next interrupt (Ethernet RX or SysTick)
+    asm volatile("wfi");
+}
+
 // Status LED functions
 void status_led_init() {
     pinMode(STATUS_LED_PIN, OUTPUT);
@@ -0,0 +1,130 @@
+#include "idle.h"
+#include "config_autogen.h"
+#include "led_driver.h"
+#include "hal/hal.h"
+
+// Fade is redrawn at ~50Hz, plenty smooth for a slow fade to black
+static const uint32_t FADE_STEP_MS = 20;
+
+// State machine states
+enum class IdleState {
+    ACTIVE,
+    FADING,
+    SLEEPING
+};
+
+static IdleState current_state = IdleState::ACTIVE;
+static uint32_t last_activity_ms = 0;
+static uint32_t fade_start_ms = 0;
+static uint32_t last_fade_step_ms = 0;
+static bool fade_black_shown = false;
+
+// Wake latency measurement
+static bool wake_pending = false;
+static uint32_t wake_start_us = 0;
+static uint32_t last_wake_us = 0;
+
+static void enter_sleep() {
+    hal::cpu_set_low_power(true);
+    current_state = IdleState::SLEEPING;
+}
+
+void idle_init() {
+    current_state = IdleState::ACTIVE;
+    last_activity_ms = hal::millis();
+    fade_start_ms = 0;
+    last_fade_step_ms = 0;
+    fade_black_shown = false;
+    wake_pending = false;
+    wake_start_us = 0;
+    last_wake_us = 0;
+}
+
+static void wake(bool measure_latency) {
+    last_activity_ms = hal::millis();
+
+    if (current_state == IdleState::SLEEPING) {
+        // Latency includes the clock switch (micros() is valid at either clock)
+        if (measure_latency) {
+            wake_pending = true;
+            wake_start_us = hal::micros();
+        }
+
+        // Restore full clock before any frame work
+        hal::cpu_set_low_power(false);
+    }
+
+    // A fade in progress is simply abandoned; the next frame overwrites it
+    current_state = IdleState::ACTIVE;
+}
+
+void idle_note_activity() {
+    wake(true);
+}
+
+void idle_restore_clock() {
+    wake(false);
+}
+
+void idle_poll() {
+    if (IDLE_TIMEOUT_MS == 0) {
+        return;
+    }
+
+    uint32_t now = hal::millis();
+
+    switch (current_state) {
+        case IdleState::ACTIVE:
+            if (now - last_activity_ms >= IDLE_TIMEOUT_MS) {
+                current_state = IdleState::FADING;
+                fade_start_ms = now;
+                last_fade_step_ms = now;
+                fade_black_shown = false;
+            }
+            break;
+
+        case IdleState::FADING: {
+            // Never change the clock or redraw while DMA is transmitting
+            if (driver_is_busy()) {
+                break;
+            }
+
+            uint32_t fade_ms = IDLE_FADE_MS;
+            uint32_t elapsed = now - fade_start_ms;
+            if (elapsed < fade_ms) {
+                if (now - last_fade_step_ms >= FADE_STEP_MS) {
+                    last_fade_step_ms = now;
+                    driver_show_last_frame_scaled((uint8_t)(255 - (elapsed * 255) / fade_ms));
+                }
+            } else if (fade_ms > 0 && !fade_black_shown) {
+                // Black frame must finish transmitting at full clock,
+                // so sleep is entered on a later poll once DMA is idle
+                driver_show_black();
+                fade_black_shown = true;
+            } else {
+                enter_sleep();
+            }
+            break;
+        }
+
+        case IdleState::SLEEPING:
+            // Sleep until Ethernet RX or the 1ms tick wakes the core
+            hal::wait_for_interrupt();
+            break;
+    }
+}
+
+void idle_frame_displayed() {
+    if (wake_pending) {
+        wake_pending = false;
+        last_wake_us = hal::micros() - wake_start_us;
+    }
+}
+
+bool idle_is_active() {
+    return current_state != IdleState::ACTIVE;
+}
+
+uint32_t idle_get_last_wake_us() {
+    return last_wake_us;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Initialize idle state, treating now as the last stream activity
+void idle_init();
+
+// Notify that a packet arrived (wakes from idle, restoring full clock)
+void idle_note_activity();
+
+// Wake from idle without measuring wake latency, for work that doesn't
+// display a frame (e.g. the benchmark)
+void idle_restore_clock();
+
+// Poll the idle state machine
+// Call at the end of the main loop - fades out, lowers the clock and
+// sleeps until the next interrupt once the stream has been silent for
+// IDLE_TIMEOUT_MS
+void idle_poll();
+
+// Notify that a frame was displayed (completes wake latency measurement)
+void idle_frame_displayed();
+
+// Check if the controller is idle (fading out or sleeping)
+bool idle_is_active();
+
+// Latency from the waking packet to the first displayed frame, in
+// microseconds (0 until the first wake completes)
+uint32_t idle_get_last_wake_us();
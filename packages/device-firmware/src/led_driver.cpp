@@ -1,21 +1,46 @@
 #include "led_driver.h"
 #include "config_autogen.h"
 #include "hal/hal.h"
+#include <cstring>
 
 static const int NUM_STRIPS = 8;
 
 static uint32_t startup_time_ms = 0;
 static const uint32_t STARTUP_BLACKOUT_MS = 1000;
 
+// Copy of the last frame passed to driver_show_frame; the receiver reuses
+// its slot for the next frame, so the idle fade can't scale from there
+static uint8_t* last_frame = nullptr;
+static size_t frame_size = 0;
+static bool has_last_frame = false;
+
 void driver_init() {
     hal::leds_init(MAX_LEDS);
     startup_time_ms = hal::millis();
 
+    frame_size = 0;
+    for (int run = 0; run < RUN_COUNT; run++) {
+        frame_size += LED_COUNT[run] * 3;
+    }
+
+    // Free old buffer if re-initializing
+    if (last_frame != nullptr) {
+        delete[] last_frame;
+    }
+    last_frame = new uint8_t[frame_size];
+
     // Set all LEDs to black initially
     driver_show_black();
 }
 
 void driver_show_frame(const uint8_t* frame_data) {
+    memcpy(last_frame, frame_data, frame_size);
+    has_last_frame = true;
+    driver_encode_frame(frame_data);
+    hal::leds_show();
+}
+
+void driver_encode_frame(const uint8_t* frame_data) {
     // Frame data is RGB, need to copy to LED buffer
     // Frame layout: run0 data, run1 data, run2 data, ...
     // Each run has LED_COUNT[run] * 3 bytes (RGB)
@@ -45,11 +70,37 @@ void driver_show_frame(const uint8_t* frame_data) {
             hal::leds_set_pixel(run, i, 0, 0, 0);
         }
     }
+}
+
+void driver_show_last_frame_scaled(uint8_t level) {
+    if (!has_last_frame) {
+        driver_show_black();
+        return;
+    }
+
+    // Only the configured LEDs are rewritten; the tails were already
+    // cleared by driver_show_frame
+    const uint8_t* src = last_frame;
+
+    for (int run = 0; run < RUN_COUNT; run++) {
+        int led_count = LED_COUNT[run];
+
+        for (int i = 0; i < led_count; i++) {
+            uint8_t r = (uint8_t)((*src++ * level) / 255);
+            uint8_t g = (uint8_t)((*src++ * level) / 255);
+            uint8_t b = (uint8_t)((*src++ * level) / 255);
+
+            hal::leds_set_pixel(run, i, r, g, b);
+        }
+    }
 
     hal::leds_show();
 }
 
 void driver_show_black() {
+    // Black is now the last frame shown
+    has_last_frame = false;
+
     for (int strip = 0; strip < NUM_STRIPS; strip++) {
         for (int i = 0; i < MAX_LEDS; i++) {
             hal::leds_set_pixel(strip, i, 0, 0, 0);
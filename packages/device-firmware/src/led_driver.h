@@ -10,7 +10,15 @@ void driver_init();
 // Frame layout: run0[LED_COUNT[0]*3], run1[LED_COUNT[1]*3], ...
 void driver_show_frame(const uint8_t* frame_data);
 
-// Set all LEDs to black
+// Copy a frame into the LED buffer without starting output
+// (driver_show_frame is encode + show)
+void driver_encode_frame(const uint8_t* frame_data);
+
+// Redisplay the last frame shown, with every channel scaled by level/255
+// (shows black if no frame has been displayed yet)
+void driver_show_last_frame_scaled(uint8_t level);
+
+// Set all LEDs to black (also forgets the last frame)
 void driver_show_black();
 
 // Check if DMA is still transmitting
@@ -6,6 +6,9 @@
 #include "status.h"
 #include "led_status.h"
 #include "wakeup.h"
+#include "idle.h"
+#include "benchmark.h"
+#include "calibration.h"
 #include <cstdio>
 
 extern "C" void setup() {
@@ -30,6 +33,12 @@ extern "C" void setup() {
     // Initialize onboard LED indicator
     led_status_init();
 
+    // Initialize idle power-save
+    idle_init();
+
+    // Initialize calibration patterns (none active)
+    calibration_init();
+
     char buf[64];
     hal::serial_println("Teensy LED Controller initialized");
     snprintf(buf, sizeof(buf), "Side: %s", SIDE_ID);
@@ -50,18 +59,31 @@ extern "C" void loop() {
     // Poll network for incoming UDP packets
     network_poll();
 
-    // Check if we have a complete frame ready
-    if (driver_ready_for_frames()) {
+    // Calibration patterns replace the stream while active
+    if (calibration_is_active()) {
+        calibration_poll();
+    } else if (driver_ready_for_frames()) {
+        // Check if we have a complete frame ready
         const uint8_t* frame = receiver_get_complete_frame();
         if (frame != nullptr && !driver_is_busy()) {
             driver_show_frame(frame);
             led_status_frame_displayed();
+            idle_frame_displayed();
         }
     }
 
+    // Run a requested self-benchmark between frames
+    benchmark_poll();
+
     // Send heartbeat if interval elapsed
     status_poll();
 
     // Update onboard LED status
     led_status_poll();
+
+    // Fade out and sleep between interrupts once the stream goes silent
+    // (kept awake while a calibration pattern is showing)
+    if (!calibration_is_active()) {
+        idle_poll();
+    }
 }
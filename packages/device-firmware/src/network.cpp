@@ -1,25 +1,45 @@
 #include "network.h"
 #include "config_autogen.h"
 #include "receiver.h"
+#include "idle.h"
+#include "control.h"
+#include "ddp.h"
 #include "hal/hal.h"
 
 // Callback adapter: hal callback -> receiver
 static void packet_callback(uint8_t run_index, const uint8_t* data, size_t len) {
+    idle_note_activity();
     receiver_handle_packet(run_index, data, len);
 }
 
+// Callback adapter: hal control callback -> control
+static void control_callback(const uint8_t* data, size_t len) {
+    control_handle_packet(data, len);
+}
+
+// Callback adapter: hal DDP callback -> ddp (wakes from idle once validated)
+static void ddp_callback(const uint8_t* data, size_t len) {
+    ddp_handle_packet(data, len);
+}
+
 void network_init() {
     hal::network_init();
 }
 
 void network_poll() {
     hal::network_poll(packet_callback);
+    hal::network_poll_control(control_callback);
+    hal::network_poll_ddp(ddp_callback);
 }
 
 void network_send_status(const char* json, size_t len) {
     hal::network_send_udp(json, len);
 }
 
+void network_send_control_reply(const char* json, size_t len) {
+    hal::network_send_control_reply(json, len);
+}
+
 bool network_link_up() {
     return hal::network_link_up();
 }
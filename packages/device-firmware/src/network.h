@@ -6,12 +6,15 @@
 // Initialize QNEthernet with static IP, bind UDP sockets
 void network_init();
 
-// Poll for incoming UDP packets, dispatch to receiver
+// Poll for incoming UDP packets, dispatch to receiver, control and DDP
 void network_poll();
 
 // Send status JSON to sender
 void network_send_status(const char* json, size_t len);
 
+// Send control reply JSON to the last control packet's sender
+void network_send_control_reply(const char* json, size_t len);
+
 // Check if Ethernet link is up
 bool network_link_up();
 
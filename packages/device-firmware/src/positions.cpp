@@ -0,0 +1,37 @@
+// Only this translation unit instantiates the generated table
+#define POSITION_TABLE_DEFINE
+#include "positions.h"
+
+static const uint16_t FIXED_MAX = 65535;
+
+const LedPosition* positions_for_run(int run_index) {
+    if (run_index < 0 || run_index >= RUN_COUNT) {
+        return nullptr;
+    }
+
+    int offset = 0;
+    for (int i = 0; i < run_index; i++) {
+        offset += LED_COUNT[i];
+    }
+    return &LED_POSITIONS[offset];
+}
+
+LedPosition positions_get(int run_index, int led_index) {
+    const LedPosition* run = positions_for_run(run_index);
+    if (run == nullptr || led_index < 0 || led_index >= LED_COUNT[run_index]) {
+        return {0, 0, 0};
+    }
+    return run[led_index];
+}
+
+float positions_to_units(uint16_t value, int axis) {
+    if (axis < 0 || axis > 2) {
+        return 0.0f;
+    }
+    float span = POSITION_MAX[axis] - POSITION_MIN[axis];
+    return POSITION_MIN[axis] + span * value / FIXED_MAX;
+}
+
+uint32_t positions_table_bytes() {
+    return POSITION_TABLE_BYTES;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include "config_autogen.h"
+
+// Per-LED 3D positions precomputed by gen_config.py, for on-device stages
+// (local effects, spatial dithering, power limiting) without per-frame math.
+// Values are fixed point: 0..65535 spans POSITION_MIN..POSITION_MAX per axis.
+
+// Positions for a run, LED_COUNT[run_index] entries in physical order
+// (nullptr for an invalid run)
+const LedPosition* positions_for_run(int run_index);
+
+// Position of one LED (all zero if out of range)
+LedPosition positions_get(int run_index, int led_index);
+
+// Convert a fixed-point coordinate on an axis (0 = x, 1 = y, 2 = z) to layout units
+float positions_to_units(uint16_t value, int axis);
+
+// Flash used by the position table, in bytes
+uint32_t positions_table_bytes();
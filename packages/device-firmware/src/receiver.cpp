@@ -58,6 +58,13 @@ static bool has_error = false;
 // Complete frame ready for display
 static const uint8_t* complete_frame = nullptr;
 
+// DDP assembly: slots are used as back/front buffers, swapped on push
+static bool ddp_mode = false;
+static int ddp_back = 0;
+
+// DDP back buffer saved by receiver_checkpoint (slots are reused meanwhile)
+static uint8_t* checkpoint_buffer = nullptr;
+
 // Helper: check if frame_id a is newer than b (handles wraparound)
 static bool newer(uint32_t a, uint32_t b) {
     return (int32_t)(a - b) > 0;
@@ -86,6 +93,11 @@ void receiver_init() {
     frame_buffer = new uint8_t[frame_size * NUM_SLOTS];
     memset(frame_buffer, 0, frame_size * NUM_SLOTS);
 
+    if (checkpoint_buffer != nullptr) {
+        delete[] checkpoint_buffer;
+    }
+    checkpoint_buffer = new uint8_t[frame_size];
+
     // Initialize slots
     for (int i = 0; i < NUM_SLOTS; i++) {
         slots[i].frame_id = 0;
@@ -99,6 +111,8 @@ void receiver_init() {
     session_initialized = false;
     last_applied_frame_id = 0;
     complete_frame = nullptr;
+    ddp_mode = false;
+    ddp_back = 0;
 
     // Reset stats and error
     stats = {0};
@@ -179,6 +193,7 @@ void receiver_handle_packet(uint8_t run_index, const uint8_t* data, size_t len)
         current_session_id = session_id;
         session_initialized = true;
         last_applied_frame_id = 0;
+        ddp_mode = false;
         clear_slots();
     }
 
@@ -215,6 +230,54 @@ void receiver_handle_packet(uint8_t run_index, const uint8_t* data, size_t len)
     }
 }
 
+static void enter_ddp_mode() {
+    if (ddp_mode) {
+        return;
+    }
+
+    snprintf(error_buffer, sizeof(error_buffer),
+             "%lu: source change -> DDP", (unsigned long)hal::millis());
+    has_error = true;
+
+    // Run-packet senders will be treated as a new session
+    session_initialized = false;
+    last_applied_frame_id = 0;
+    clear_slots();
+    complete_frame = nullptr;
+
+    ddp_mode = true;
+    ddp_back = 0;
+}
+
+void receiver_handle_ddp(uint32_t offset, const uint8_t* rgb, size_t len, bool push) {
+    stats.rx_frames++;
+    enter_ddp_mode();
+
+    // Data beyond the configured LEDs is clipped
+    if (len > 0) {
+        if (offset >= frame_size) {
+            stats.drops_len++;
+        } else {
+            size_t copy_len = len < frame_size - offset ? len : frame_size - offset;
+            memcpy(slots[ddp_back].rgb_data + offset, rgb, copy_len);
+        }
+    }
+
+    if (!push) {
+        return;
+    }
+
+    stats.complete_frames++;
+
+    // Front buffer is never written while it is pending display
+    uint8_t* front = slots[ddp_back].rgb_data;
+    complete_frame = front;
+    ddp_back ^= 1;
+
+    // Seed the next frame so pixels not rewritten keep their values
+    memcpy(slots[ddp_back].rgb_data, front, frame_size);
+}
+
 const uint8_t* receiver_get_complete_frame() {
     const uint8_t* frame = complete_frame;
     complete_frame = nullptr;
@@ -239,3 +302,40 @@ const char* receiver_get_last_error() {
 void receiver_clear_last_error() {
     has_error = false;
 }
+
+ReceiverCheckpoint receiver_checkpoint() {
+    ReceiverCheckpoint checkpoint;
+    checkpoint.session_id = current_session_id;
+    checkpoint.session_initialized = session_initialized;
+    checkpoint.last_applied_frame_id = last_applied_frame_id;
+    checkpoint.stats = stats;
+    checkpoint.has_error = has_error;
+    memcpy(checkpoint.error, error_buffer, sizeof(checkpoint.error));
+    checkpoint.ddp_mode = ddp_mode;
+    checkpoint.ddp_back = ddp_back;
+
+    // Pixels not rewritten by the next DDP frame must keep their values
+    if (ddp_mode) {
+        memcpy(checkpoint_buffer, slots[ddp_back].rgb_data, frame_size);
+    }
+    return checkpoint;
+}
+
+void receiver_restore(const ReceiverCheckpoint& checkpoint) {
+    clear_slots();
+    complete_frame = nullptr;
+
+    // The front buffer is reseeded from the back buffer on the next push
+    if (checkpoint.ddp_mode) {
+        memcpy(slots[checkpoint.ddp_back].rgb_data, checkpoint_buffer, frame_size);
+    }
+
+    current_session_id = checkpoint.session_id;
+    session_initialized = checkpoint.session_initialized;
+    last_applied_frame_id = checkpoint.last_applied_frame_id;
+    stats = checkpoint.stats;
+    has_error = checkpoint.has_error;
+    memcpy(error_buffer, checkpoint.error, sizeof(error_buffer));
+    ddp_mode = checkpoint.ddp_mode;
+    ddp_back = checkpoint.ddp_back;
+}
@@ -9,6 +9,12 @@ void receiver_init();
 // Handle an incoming UDP packet for a specific run
 void receiver_handle_packet(uint8_t run_index, const uint8_t* data, size_t len);
 
+// Handle DDP data: write RGB bytes at a byte offset into the frame (same
+// run-concatenated layout), and on push mark the frame complete. Unwritten
+// pixels keep their previous values. The first DDP packet discards any
+// in-flight run-packet assembly; the next run packet switches back.
+void receiver_handle_ddp(uint32_t offset, const uint8_t* rgb, size_t len, bool push);
+
 // Get pointer to complete frame data if available, nullptr otherwise
 // Returns pointer to RGB data: run0[LED_COUNT[0]*3], run1[LED_COUNT[1]*3], ...
 const uint8_t* receiver_get_complete_frame();
@@ -30,3 +36,24 @@ const char* receiver_get_last_error();
 
 // Clear the last error after including in heartbeat
 void receiver_clear_last_error();
+
+// Session tracking, stats and error state, saved so synthetic traffic
+// (e.g. the on-target benchmark) can run without disturbing the live stream
+struct ReceiverCheckpoint {
+    uint16_t session_id;
+    bool session_initialized;
+    uint32_t last_applied_frame_id;
+    ReceiverStats stats;
+    bool has_error;
+    char error[128];
+    bool ddp_mode;
+    int ddp_back;
+};
+
+// Save live receiver state. The DDP back buffer is saved inside the
+// receiver, so only one checkpoint can be outstanding at a time.
+ReceiverCheckpoint receiver_checkpoint();
+
+// Restore live receiver state; in-flight run-packet assembly is discarded,
+// DDP pixels (including unpushed writes) are kept
+void receiver_restore(const ReceiverCheckpoint& checkpoint);
@@ -2,6 +2,7 @@
 #include "config_autogen.h"
 #include "network.h"
 #include "receiver.h"
+#include "idle.h"
 #include "hal/hal.h"
 #include <cstdio>
 
@@ -31,12 +32,25 @@ void status_poll() {
     // Get error message if any
     const char* error = receiver_get_last_error();
 
+    int len = status_build_heartbeat(json_buffer, sizeof(json_buffer), stats, error);
+    if (error != nullptr) {
+        receiver_clear_last_error();
+    }
+
+    // Send heartbeat
+    network_send_status(json_buffer, len);
+}
+
+int status_build_heartbeat(char* buffer, size_t size,
+                           const ReceiverStats& stats, const char* error) {
+    uint32_t now = hal::millis();
+
     // Build JSON heartbeat
     // Format: {"id":"LEFT","ip":"10.10.0.2","uptime_ms":123456,...}
 
     int pos = 0;
 
-    pos += snprintf(json_buffer + pos, sizeof(json_buffer) - pos,
+    pos += snprintf(buffer + pos, size - pos,
                     "{\"id\":\"%s\",\"ip\":\"%s\",\"uptime_ms\":%lu,\"link\":%s,\"runs\":%d,\"leds\":[",
                     SIDE_ID,
                     network_get_ip_string(),
@@ -47,34 +61,34 @@ void status_poll() {
     // LED counts array
     for (int i = 0; i < RUN_COUNT; i++) {
         if (i > 0) {
-            pos += snprintf(json_buffer + pos, sizeof(json_buffer) - pos, ",");
+            pos += snprintf(buffer + pos, size - pos, ",");
         }
-        pos += snprintf(json_buffer + pos, sizeof(json_buffer) - pos, "%d", LED_COUNT[i]);
+        pos += snprintf(buffer + pos, size - pos, "%d", LED_COUNT[i]);
     }
 
-    pos += snprintf(json_buffer + pos, sizeof(json_buffer) - pos,
-                    "],\"rx_frames\":%lu,\"complete\":%lu,\"applied\":%lu,\"dropped_frames\":%lu,\"errors\":[",
+    pos += snprintf(buffer + pos, size - pos,
+                    "],\"rx_frames\":%lu,\"complete\":%lu,\"applied\":%lu,\"dropped_frames\":%lu,\"idle\":%s,\"wake_us\":%lu,\"errors\":[",
                     (unsigned long)stats.rx_frames,
                     (unsigned long)stats.complete_frames,
                     (unsigned long)stats.applied_frames,
-                    (unsigned long)(stats.drops_len + stats.drops_stale));
+                    (unsigned long)(stats.drops_len + stats.drops_stale),
+                    idle_is_active() ? "true" : "false",
+                    (unsigned long)idle_get_last_wake_us());
 
     // Error array
     if (error != nullptr) {
         // Escape any quotes in error message
-        pos += snprintf(json_buffer + pos, sizeof(json_buffer) - pos, "\"");
-        for (const char* p = error; *p && pos < (int)sizeof(json_buffer) - 10; p++) {
+        pos += snprintf(buffer + pos, size - pos, "\"");
+        for (const char* p = error; *p && pos < (int)size - 10; p++) {
             if (*p == '"' || *p == '\\') {
-                json_buffer[pos++] = '\\';
+                buffer[pos++] = '\\';
             }
-            json_buffer[pos++] = *p;
+            buffer[pos++] = *p;
         }
-        pos += snprintf(json_buffer + pos, sizeof(json_buffer) - pos, "\"");
-        receiver_clear_last_error();
+        pos += snprintf(buffer + pos, size - pos, "\"");
     }
 
-    pos += snprintf(json_buffer + pos, sizeof(json_buffer) - pos, "]}");
+    pos += snprintf(buffer + pos, size - pos, "]}");
 
-    // Send heartbeat
-    network_send_status(json_buffer, pos);
+    return pos;
 }
@@ -1,7 +1,15 @@
 #pragma once
 
+#include <cstddef>
+#include "receiver.h"
+
 // Initialize status module, record startup time
 void status_init();
 
 // Poll for heartbeat interval, send if 1s elapsed
 void status_poll();
+
+// Build heartbeat JSON for the given stats and error (nullptr for none)
+// Returns the JSON length written to buffer
+int status_build_heartbeat(char* buffer, size_t size,
+                           const ReceiverStats& stats, const char* error);
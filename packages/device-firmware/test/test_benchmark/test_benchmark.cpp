@@ -0,0 +1,227 @@
+#include <unity.h>
+#include "../../src/hal/hal.h"
+#include "../../src/benchmark.h"
+#include "../../src/control.h"
+#include "../../src/ddp.h"
+#include "../../src/idle.h"
+#include "../../src/led_driver.h"
+#include "../../src/network.h"
+#include "../../src/receiver.h"
+#include "../../src/config_autogen.h"
+#include <cstdio>
+#include <cstring>
+
+static void build_packet(uint8_t* buffer, uint16_t session_id, uint32_t frame_id,
+                         uint8_t value, int led_count) {
+    buffer[0] = (session_id >> 8) & 0xFF;
+    buffer[1] = session_id & 0xFF;
+    buffer[2] = (frame_id >> 24) & 0xFF;
+    buffer[3] = (frame_id >> 16) & 0xFF;
+    buffer[4] = (frame_id >> 8) & 0xFF;
+    buffer[5] = frame_id & 0xFF;
+    memset(buffer + 6, value, led_count * 3);
+}
+
+static void handle_complete_frame(uint16_t session_id, uint32_t frame_id, uint8_t value) {
+    for (int run = 0; run < RUN_COUNT; run++) {
+        uint8_t buffer[6 + 800 * 3];
+        build_packet(buffer, session_id, frame_id, value, LED_COUNT[run]);
+        receiver_handle_packet(run, buffer, 6 + LED_COUNT[run] * 3);
+    }
+}
+
+void setUp(void) {
+    hal::test::reset();
+    driver_init();
+    receiver_init();
+    idle_init();
+}
+
+void tearDown(void) {
+}
+
+// Test: every stage records sane cycle counts (and prints host numbers)
+void test_benchmark_run_reports_all_stages(void) {
+    BenchmarkResults results = benchmark_run(50);
+
+    TEST_ASSERT_EQUAL(50, results.iterations);
+    TEST_ASSERT_EQUAL(hal::cycle_count_hz(), results.cycle_hz);
+
+    const BenchmarkStage* stages[] = {&results.ingest, &results.encode, &results.heartbeat};
+    for (const BenchmarkStage* stage : stages) {
+        TEST_ASSERT_TRUE(stage->min <= stage->avg);
+        TEST_ASSERT_TRUE(stage->avg <= stage->max);
+    }
+
+    char json[512];
+    benchmark_format_json(results, json, sizeof(json));
+    printf("%s\n", json);
+}
+
+// Test: iteration count defaults when 0 and is clamped to the maximum
+void test_benchmark_iterations_clamped(void) {
+    TEST_ASSERT_EQUAL(BENCHMARK_DEFAULT_ITERATIONS, benchmark_run(0).iterations);
+    TEST_ASSERT_EQUAL(BENCHMARK_MAX_ITERATIONS, benchmark_run(60000).iterations);
+}
+
+// Test: live session, stats and pending error survive a benchmark
+void test_benchmark_preserves_receiver_state(void) {
+    handle_complete_frame(0x1234, 10, 1);
+    TEST_ASSERT_NOT_NULL(receiver_get_complete_frame());
+
+    benchmark_run(10);
+
+    // Stats only reflect live traffic
+    ReceiverStats stats = receiver_get_and_reset_stats();
+    TEST_ASSERT_EQUAL(RUN_COUNT, stats.rx_frames);
+    TEST_ASSERT_EQUAL(1, stats.complete_frames);
+    TEST_ASSERT_EQUAL(1, stats.applied_frames);
+
+    // Original session change error is still pending
+    const char* error = receiver_get_last_error();
+    TEST_ASSERT_NOT_NULL(error);
+    TEST_ASSERT_NOT_EQUAL(nullptr, strstr(error, "-> 4660"));
+    receiver_clear_last_error();
+
+    // Same session continues without a session change; stale frames still drop
+    handle_complete_frame(0x1234, 9, 2);
+    TEST_ASSERT_NULL(receiver_get_complete_frame());
+    handle_complete_frame(0x1234, 11, 3);
+    TEST_ASSERT_NOT_NULL(receiver_get_complete_frame());
+    TEST_ASSERT_NULL(receiver_get_last_error());
+}
+
+// Test: DDP pixels, including unpushed writes, survive a benchmark
+void test_benchmark_preserves_ddp_pixels(void) {
+    // DDP v1 packet, RGB 8-bit, display destination
+    uint8_t packet[10 + 800 * 3] = {0x41, 0x00, 0x0B, 0x01};
+    size_t size = 0;
+    for (int run = 0; run < RUN_COUNT; run++) {
+        size += LED_COUNT[run] * 3;
+    }
+
+    // Whole frame of 9s, pushed in 800-LED chunks
+    for (size_t offset = 0; offset < size; offset += 800 * 3) {
+        size_t len = size - offset < 800 * 3 ? size - offset : 800 * 3;
+        packet[0] = offset + len == size ? 0x41 : 0x40;
+        packet[4] = (offset >> 24) & 0xFF;
+        packet[5] = (offset >> 16) & 0xFF;
+        packet[6] = (offset >> 8) & 0xFF;
+        packet[7] = offset & 0xFF;
+        packet[8] = (len >> 8) & 0xFF;
+        packet[9] = len & 0xFF;
+        memset(packet + 10, 9, len);
+        ddp_handle_packet(packet, 10 + len);
+    }
+    TEST_ASSERT_NOT_NULL(receiver_get_complete_frame());
+
+    // Unpushed write to the first LED
+    uint8_t partial[] = {0x40, 0x00, 0x0B, 0x01, 0, 0, 0, 0, 0, 3, 7, 7, 7};
+    ddp_handle_packet(partial, sizeof(partial));
+
+    benchmark_run(5);
+
+    // Zero-length push displays the kept pixels
+    uint8_t push[] = {0x41, 0x00, 0x0B, 0x01, 0, 0, 0, 0, 0, 0};
+    ddp_handle_packet(push, sizeof(push));
+
+    const uint8_t* frame = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(frame);
+    TEST_ASSERT_EQUAL(7, frame[0]);
+    TEST_ASSERT_EQUAL(9, frame[3]);
+    TEST_ASSERT_EQUAL(9, frame[size - 1]);
+}
+
+// Test: benchmark does not output to the LEDs
+void test_benchmark_does_not_show(void) {
+    int shows_before = hal::test::get_show_count();
+    benchmark_run(10);
+    TEST_ASSERT_EQUAL(shows_before, hal::test::get_show_count());
+}
+
+// Test: the idle fade still starts from the displayed frame after a benchmark
+void test_benchmark_then_fade(void) {
+    handle_complete_frame(0x1234, 10, 200);
+    const uint8_t* frame = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(frame);
+    driver_show_frame(frame);
+
+    benchmark_run(5);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    idle_poll();
+    hal::test::advance_time(IDLE_FADE_MS / 2);
+    idle_poll();
+
+    auto led = hal::test::get_led(0, 0);
+    TEST_ASSERT_TRUE(led.r > 80 && led.r < 120);
+}
+
+// Test: control packet triggers a benchmark whose results are sent back
+void test_benchmark_control_command_replies(void) {
+    uint8_t command[] = {CONTROL_CMD_BENCHMARK, 0x00, 0x14};
+    hal::test::inject_control_packet(command, sizeof(command));
+    network_poll();
+
+    // Runs between frames, from the main loop
+    TEST_ASSERT_EQUAL(0, hal::test::get_sent_control_replies().size());
+    benchmark_poll();
+
+    auto& replies = hal::test::get_sent_control_replies();
+    TEST_ASSERT_EQUAL(1, replies.size());
+
+    const std::string& json = replies[0];
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"type\":\"benchmark\""));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"iterations\":20"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"cycle_hz\":"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"ingest\":{\"min\":"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"encode\":{\"min\":"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, json.find("\"heartbeat\":{\"min\":"));
+
+    // Only runs once per request
+    benchmark_poll();
+    TEST_ASSERT_EQUAL(1, replies.size());
+}
+
+// Test: a benchmark requested while asleep runs at full clock
+void test_benchmark_wakes_from_idle(void) {
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    for (uint32_t t = 0; t <= IDLE_FADE_MS + 100 && !hal::test::get_cpu_low_power(); t += 10) {
+        idle_poll();
+        hal::test::advance_time(10);
+    }
+    TEST_ASSERT_TRUE(hal::test::get_cpu_low_power());
+
+    uint8_t command[] = {CONTROL_CMD_BENCHMARK};
+    hal::test::inject_control_packet(command, sizeof(command));
+    network_poll();
+    benchmark_poll();
+
+    TEST_ASSERT_FALSE(hal::test::get_cpu_low_power());
+    TEST_ASSERT_FALSE(idle_is_active());
+    TEST_ASSERT_EQUAL(1, hal::test::get_sent_control_replies().size());
+
+    // No frame was displayed, so the stream resuming later is not a wake
+    hal::test::advance_time(10000);
+    handle_complete_frame(0x1234, 1, 50);
+    const uint8_t* frame = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(frame);
+    driver_show_frame(frame);
+    idle_frame_displayed();
+    TEST_ASSERT_EQUAL(0, idle_get_last_wake_us());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_benchmark_run_reports_all_stages);
+    RUN_TEST(test_benchmark_iterations_clamped);
+    RUN_TEST(test_benchmark_preserves_receiver_state);
+    RUN_TEST(test_benchmark_preserves_ddp_pixels);
+    RUN_TEST(test_benchmark_does_not_show);
+    RUN_TEST(test_benchmark_then_fade);
+    RUN_TEST(test_benchmark_control_command_replies);
+    RUN_TEST(test_benchmark_wakes_from_idle);
+
+    return UNITY_END();
+}
@@ -0,0 +1,208 @@
+#include <unity.h>
+#include "../../src/hal/hal.h"
+#include "../../src/calibration.h"
+#include "../../src/control.h"
+#include "../../src/idle.h"
+#include "../../src/led_driver.h"
+#include "../../src/network.h"
+#include "../../src/config_autogen.h"
+#include <cstring>
+
+// Physical index of the x0 / x1 ends of a section
+static int x0_end(const SectionInfo& section) {
+    return section.direction < 0 ? section.start + section.count - 1 : section.start;
+}
+
+static int x1_end(const SectionInfo& section) {
+    return section.direction < 0 ? section.start : section.start + section.count - 1;
+}
+
+static bool is_black(int strip, int index) {
+    auto led = hal::test::get_led(strip, index);
+    return led.r == 0 && led.g == 0 && led.b == 0;
+}
+
+// Send a pattern command through the control port
+static void send_pattern(uint8_t pattern, const char* section_id) {
+    uint8_t packet[32];
+    packet[0] = CONTROL_CMD_PATTERN;
+    packet[1] = pattern;
+    size_t id_len = strlen(section_id);
+    memcpy(packet + 2, section_id, id_len);
+    hal::test::inject_control_packet(packet, 2 + id_len);
+    network_poll();
+}
+
+void setUp(void) {
+    hal::test::reset();
+    driver_init();
+    calibration_init();
+    idle_init();
+}
+
+void tearDown(void) {
+}
+
+// Test: section table matches the per-run LED counts
+void test_section_table_fits_runs(void) {
+    TEST_ASSERT_GREATER_THAN(0, SECTION_COUNT);
+
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        const SectionInfo& section = SECTIONS[i];
+        TEST_ASSERT_LESS_THAN(RUN_COUNT, section.run);
+        TEST_ASSERT_LESS_OR_EQUAL(LED_COUNT[section.run], section.start + section.count);
+        TEST_ASSERT_TRUE(section.direction == 1 || section.direction == -1);
+    }
+}
+
+// Test: unknown section ids and patterns are rejected
+void test_calibration_rejects_unknown(void) {
+    TEST_ASSERT_FALSE(calibration_start(CalibrationPattern::IDENTIFY, "no_such_section"));
+    TEST_ASSERT_FALSE(calibration_start((CalibrationPattern)9, SECTIONS[0].id));
+    TEST_ASSERT_FALSE(calibration_is_active());
+}
+
+// Test: identify lights only the requested section, then blinks off
+void test_calibration_identify_lights_only_section(void) {
+    const SectionInfo& section = SECTIONS[SECTION_COUNT - 1];
+    TEST_ASSERT_TRUE(calibration_start(CalibrationPattern::IDENTIFY, section.id));
+    calibration_poll();
+
+    for (int run = 0; run < RUN_COUNT; run++) {
+        for (int i = 0; i < LED_COUNT[run]; i++) {
+            bool in_section = run == section.run &&
+                              i >= section.start && i < section.start + section.count;
+            TEST_ASSERT_EQUAL(in_section, !is_black(run, i));
+        }
+    }
+
+    // Blink phase off
+    hal::test::advance_time(250);
+    calibration_poll();
+    TEST_ASSERT_TRUE(is_black(section.run, section.start));
+}
+
+// Physical index of the i-th LED counting from the x0 end
+static int from_x0(const SectionInfo& section, int i) {
+    return section.direction < 0 ? section.start + section.count - 1 - i : section.start + i;
+}
+
+// Test: gradient is red at the x0 end and blue at the x1 end, in every
+// section (reversed sections included)
+void test_calibration_gradient_follows_direction(void) {
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        const SectionInfo& section = SECTIONS[s];
+        if (section.count < 2) {
+            continue;
+        }
+        TEST_ASSERT_TRUE(calibration_start(CalibrationPattern::GRADIENT, section.id));
+        calibration_poll();
+
+        auto start = hal::test::get_led(section.run, x0_end(section));
+        auto end = hal::test::get_led(section.run, x1_end(section));
+        TEST_ASSERT_EQUAL(255, start.r);
+        TEST_ASSERT_EQUAL(0, start.b);
+        TEST_ASSERT_EQUAL(0, end.r);
+        TEST_ASSERT_EQUAL(255, end.b);
+
+        // Red fades out steadily from the x0 end
+        for (int i = 1; i < section.count; i++) {
+            TEST_ASSERT_TRUE(hal::test::get_led(section.run, from_x0(section, i)).r <=
+                             hal::test::get_led(section.run, from_x0(section, i - 1)).r);
+        }
+    }
+}
+
+// Test: chase head starts at the x0 end and moves towards the x1 end, in
+// every section (reversed sections included)
+void test_calibration_chase_moves_from_x0(void) {
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        const SectionInfo& section = SECTIONS[s];
+        if (section.count < 2) {
+            continue;
+        }
+        TEST_ASSERT_TRUE(calibration_start(CalibrationPattern::CHASE, section.id));
+        calibration_poll();
+
+        TEST_ASSERT_EQUAL(255, hal::test::get_led(section.run, x0_end(section)).r);
+        TEST_ASSERT_TRUE(hal::test::get_led(section.run, x1_end(section)).r < 255);
+
+        // Just before the end of one period the head is at the x1 end
+        hal::test::advance_time(1999);
+        calibration_poll();
+        TEST_ASSERT_EQUAL(255, hal::test::get_led(section.run, x1_end(section)).r);
+        TEST_ASSERT_TRUE(hal::test::get_led(section.run, x0_end(section)).r < 255);
+    }
+}
+
+// Test: control command starts a pattern, replies, and OFF blanks the LEDs
+void test_calibration_control_command(void) {
+    const SectionInfo& section = SECTIONS[0];
+    send_pattern((uint8_t)CalibrationPattern::IDENTIFY, section.id);
+
+    TEST_ASSERT_TRUE(calibration_is_active());
+    auto& replies = hal::test::get_sent_control_replies();
+    TEST_ASSERT_EQUAL(1, replies.size());
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, replies[0].find("\"ok\":true"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos,
+                          replies[0].find(std::string("\"section\":\"") + section.id + "\""));
+
+    calibration_poll();
+    TEST_ASSERT_FALSE(is_black(section.run, section.start));
+
+    send_pattern((uint8_t)CalibrationPattern::OFF, "");
+    TEST_ASSERT_FALSE(calibration_is_active());
+    TEST_ASSERT_TRUE(is_black(section.run, section.start));
+
+    // Unknown section is reported back
+    send_pattern((uint8_t)CalibrationPattern::IDENTIFY, "bogus");
+    TEST_ASSERT_EQUAL(3, replies.size());
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, replies[2].find("\"ok\":false"));
+}
+
+// Test: pattern stops on its own after the timeout
+void test_calibration_times_out(void) {
+    TEST_ASSERT_TRUE(calibration_start(CalibrationPattern::GRADIENT, SECTIONS[0].id));
+    calibration_poll();
+
+    hal::test::advance_time(60000);
+    calibration_poll();
+
+    TEST_ASSERT_FALSE(calibration_is_active());
+    TEST_ASSERT_TRUE(is_black(SECTIONS[0].run, SECTIONS[0].start));
+}
+
+// Test: only an accepted pattern wakes the controller from idle
+void test_calibration_wakes_only_when_accepted(void) {
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    for (uint32_t t = 0; t <= IDLE_FADE_MS + 100 && !hal::test::get_cpu_low_power(); t += 10) {
+        idle_poll();
+        hal::test::advance_time(10);
+    }
+    TEST_ASSERT_TRUE(hal::test::get_cpu_low_power());
+
+    send_pattern((uint8_t)CalibrationPattern::IDENTIFY, "bogus");
+    send_pattern(9, SECTIONS[0].id);
+    send_pattern((uint8_t)CalibrationPattern::OFF, "");
+    TEST_ASSERT_TRUE(hal::test::get_cpu_low_power());
+    TEST_ASSERT_TRUE(idle_is_active());
+
+    send_pattern((uint8_t)CalibrationPattern::IDENTIFY, SECTIONS[0].id);
+    TEST_ASSERT_FALSE(hal::test::get_cpu_low_power());
+    TEST_ASSERT_FALSE(idle_is_active());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_section_table_fits_runs);
+    RUN_TEST(test_calibration_rejects_unknown);
+    RUN_TEST(test_calibration_identify_lights_only_section);
+    RUN_TEST(test_calibration_gradient_follows_direction);
+    RUN_TEST(test_calibration_chase_moves_from_x0);
+    RUN_TEST(test_calibration_control_command);
+    RUN_TEST(test_calibration_times_out);
+    RUN_TEST(test_calibration_wakes_only_when_accepted);
+
+    return UNITY_END();
+}
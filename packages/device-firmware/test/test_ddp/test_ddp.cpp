@@ -0,0 +1,288 @@
+#include <unity.h>
+#include "../../src/hal/hal.h"
+#include "../../src/ddp.h"
+#include "../../src/idle.h"
+#include "../../src/led_driver.h"
+#include "../../src/network.h"
+#include "../../src/receiver.h"
+#include "../../src/config_autogen.h"
+#include <cstring>
+#include <vector>
+
+static const uint8_t FLAGS_V1 = 0x40;
+static const uint8_t FLAG_TIMECODE = 0x10;
+static const uint8_t FLAG_QUERY = 0x02;
+static const uint8_t FLAG_PUSH = 0x01;
+static const uint8_t TYPE_RGB8 = 0x0B;
+
+// Total frame size in bytes (all runs concatenated)
+static size_t frame_size() {
+    size_t total = 0;
+    for (int i = 0; i < RUN_COUNT; i++) {
+        total += LED_COUNT[i] * 3;
+    }
+    return total;
+}
+
+// Helper to build a DDP packet with header and data
+static std::vector<uint8_t> build_ddp(uint8_t flags, uint32_t offset,
+                                      const uint8_t* data, uint16_t data_len,
+                                      uint8_t destination = 1,
+                                      uint8_t data_type = TYPE_RGB8) {
+    size_t header_size = (flags & FLAG_TIMECODE) ? 14 : 10;
+    std::vector<uint8_t> packet(header_size + data_len, 0);
+    packet[0] = flags;
+    packet[1] = 0x01;
+    packet[2] = data_type;
+    packet[3] = destination;
+    packet[4] = (offset >> 24) & 0xFF;
+    packet[5] = (offset >> 16) & 0xFF;
+    packet[6] = (offset >> 8) & 0xFF;
+    packet[7] = offset & 0xFF;
+    packet[8] = (data_len >> 8) & 0xFF;
+    packet[9] = data_len & 0xFF;
+    if (data_len > 0) {
+        memcpy(packet.data() + header_size, data, data_len);
+    }
+    return packet;
+}
+
+static void handle(const std::vector<uint8_t>& packet) {
+    ddp_handle_packet(packet.data(), packet.size());
+}
+
+// Build a whole frame filled with one byte value
+static std::vector<uint8_t> filled_frame(uint8_t value) {
+    return std::vector<uint8_t>(frame_size(), value);
+}
+
+void setUp(void) {
+    hal::test::reset();
+    driver_init();
+    receiver_init();
+    idle_init();
+}
+
+void tearDown(void) {
+}
+
+// Test: single packet with PUSH completes a frame in run-concatenated layout
+void test_ddp_single_packet_push(void) {
+    std::vector<uint8_t> frame = filled_frame(0);
+    for (size_t i = 0; i < frame.size(); i++) {
+        frame[i] = (uint8_t)i;
+    }
+
+    // Split into 1440 byte chunks as real senders do, PUSH on the last
+    size_t chunk = 1440;
+    for (size_t offset = 0; offset < frame.size(); offset += chunk) {
+        size_t len = frame.size() - offset < chunk ? frame.size() - offset : chunk;
+        bool last = offset + len == frame.size();
+        handle(build_ddp(FLAGS_V1 | (last ? FLAG_PUSH : 0), offset,
+                         frame.data() + offset, len));
+        if (!last) {
+            TEST_ASSERT_NULL(receiver_get_complete_frame());
+        }
+    }
+
+    const uint8_t* complete = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(complete);
+    TEST_ASSERT_EQUAL_MEMORY(frame.data(), complete, frame.size());
+}
+
+// Test: fragments in any order only display on PUSH
+void test_ddp_push_only_packet(void) {
+    std::vector<uint8_t> frame = filled_frame(0x42);
+    size_t half = frame.size() / 2;
+
+    handle(build_ddp(FLAGS_V1, half, frame.data() + half, frame.size() - half));
+    handle(build_ddp(FLAGS_V1, 0, frame.data(), half));
+    TEST_ASSERT_NULL(receiver_get_complete_frame());
+
+    // Zero-length push
+    handle(build_ddp(FLAGS_V1 | FLAG_PUSH, 0, nullptr, 0));
+
+    const uint8_t* complete = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(complete);
+    TEST_ASSERT_EQUAL_MEMORY(frame.data(), complete, frame.size());
+}
+
+// Test: pixels not rewritten keep their previous values
+void test_ddp_partial_update_keeps_pixels(void) {
+    std::vector<uint8_t> frame = filled_frame(10);
+    handle(build_ddp(FLAGS_V1 | FLAG_PUSH, 0, frame.data(), frame.size()));
+    TEST_ASSERT_NOT_NULL(receiver_get_complete_frame());
+
+    // Update only the first LED
+    uint8_t red[] = {255, 0, 0};
+    handle(build_ddp(FLAGS_V1 | FLAG_PUSH, 0, red, 3));
+
+    const uint8_t* complete = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(complete);
+    TEST_ASSERT_EQUAL_MEMORY(red, complete, 3);
+    TEST_ASSERT_EQUAL(10, complete[3]);
+    TEST_ASSERT_EQUAL(10, complete[frame.size() - 1]);
+}
+
+// Test: next frame's data never tears a pushed frame awaiting display
+void test_ddp_pending_frame_not_torn(void) {
+    std::vector<uint8_t> first = filled_frame(1);
+    handle(build_ddp(FLAGS_V1 | FLAG_PUSH, 0, first.data(), first.size()));
+
+    // Next frame starts arriving before the main loop displays the first
+    std::vector<uint8_t> second = filled_frame(2);
+    handle(build_ddp(FLAGS_V1, 0, second.data(), second.size()));
+
+    const uint8_t* complete = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(complete);
+    TEST_ASSERT_EQUAL_MEMORY(first.data(), complete, first.size());
+}
+
+// Test: timecode flag shifts the data start
+void test_ddp_timecode_header(void) {
+    uint8_t rgb[] = {7, 8, 9};
+    handle(build_ddp(FLAGS_V1 | FLAG_TIMECODE | FLAG_PUSH, 0, rgb, 3));
+
+    const uint8_t* complete = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(complete);
+    TEST_ASSERT_EQUAL_MEMORY(rgb, complete, 3);
+}
+
+// Test: queries, wrong version, other destinations and short packets are ignored
+void test_ddp_ignores_unsupported(void) {
+    uint8_t rgb[] = {1, 2, 3};
+    handle(build_ddp(FLAGS_V1 | FLAG_QUERY | FLAG_PUSH, 0, rgb, 3));
+    handle(build_ddp(0x80 | FLAG_PUSH, 0, rgb, 3));
+    handle(build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3, 251));
+
+    std::vector<uint8_t> truncated = build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3);
+    truncated.pop_back();
+    handle(truncated);
+
+    TEST_ASSERT_NULL(receiver_get_complete_frame());
+    TEST_ASSERT_EQUAL(0, receiver_get_and_reset_stats().rx_frames);
+}
+
+// Test: every documented RGB data type is accepted
+void test_ddp_accepts_rgb_data_types(void) {
+    const uint8_t types[] = {0x00, 0x01, 0x0B};
+    for (uint8_t type : types) {
+        uint8_t rgb[] = {type, 2, 3};
+        handle(build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3, 1, type));
+
+        const uint8_t* complete = receiver_get_complete_frame();
+        TEST_ASSERT_NOT_NULL(complete);
+        TEST_ASSERT_EQUAL(type, complete[0]);
+    }
+
+    // Other pixel formats (e.g. 16-bit RGB, 0x0C) are ignored
+    uint8_t rgb[] = {1, 2, 3};
+    handle(build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3, 1, 0x0C));
+    TEST_ASSERT_NULL(receiver_get_complete_frame());
+}
+
+// Test: data past the configured LEDs is clipped and counted
+void test_ddp_out_of_range_clipped(void) {
+    size_t size = frame_size();
+    uint8_t rgb[6] = {1, 2, 3, 4, 5, 6};
+
+    // Straddles the end: first LED lands, second is clipped
+    handle(build_ddp(FLAGS_V1, size - 3, rgb, 6));
+    // Entirely beyond the end
+    handle(build_ddp(FLAGS_V1 | FLAG_PUSH, size, rgb, 6));
+
+    const uint8_t* complete = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(complete);
+    TEST_ASSERT_EQUAL_MEMORY(rgb, complete + size - 3, 3);
+
+    ReceiverStats stats = receiver_get_and_reset_stats();
+    TEST_ASSERT_EQUAL(2, stats.rx_frames);
+    TEST_ASSERT_EQUAL(1, stats.complete_frames);
+    TEST_ASSERT_EQUAL(1, stats.drops_len);
+}
+
+// Test: switching between run packets and DDP resets assembly and is reported
+void test_ddp_source_switch(void) {
+    // Partial run-packet frame in flight
+    std::vector<uint8_t> packet(6 + LED_COUNT[0] * 3, 0x11);
+    packet[0] = 0x12; packet[1] = 0x34;
+    packet[2] = 0; packet[3] = 0; packet[4] = 0; packet[5] = 5;
+    receiver_handle_packet(0, packet.data(), packet.size());
+    receiver_clear_last_error();
+
+    uint8_t rgb[] = {9, 9, 9};
+    handle(build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3));
+    TEST_ASSERT_NOT_NULL(strstr(receiver_get_last_error(), "DDP"));
+    receiver_clear_last_error();
+
+    // DDP frame contains no leftovers from the run packet
+    const uint8_t* complete = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(complete);
+    TEST_ASSERT_EQUAL(0, complete[3]);
+
+    // Returning run-packet sender is treated as a new session
+    receiver_handle_packet(0, packet.data(), packet.size());
+    TEST_ASSERT_NOT_NULL(strstr(receiver_get_last_error(), "session change"));
+}
+
+// Test: DDP port is polled by network_poll
+void test_ddp_via_network_poll(void) {
+    uint8_t rgb[] = {0, 255, 0};
+    std::vector<uint8_t> packet = build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3);
+    hal::test::inject_ddp_packet(packet.data(), packet.size());
+
+    network_poll();
+
+    const uint8_t* complete = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(complete);
+    TEST_ASSERT_EQUAL_MEMORY(rgb, complete, 3);
+}
+
+// Test: ignored packets leave a sleeping controller asleep; valid ones wake it
+void test_ddp_only_valid_packets_wake(void) {
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    for (uint32_t t = 0; t <= IDLE_FADE_MS + 100 && !hal::test::get_cpu_low_power(); t += 10) {
+        idle_poll();
+        hal::test::advance_time(10);
+    }
+    TEST_ASSERT_TRUE(hal::test::get_cpu_low_power());
+
+    uint8_t rgb[] = {1, 2, 3};
+    std::vector<uint8_t> query = build_ddp(FLAGS_V1 | FLAG_QUERY, 0, nullptr, 0, 251);
+    std::vector<uint8_t> other_destination = build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3, 251);
+    std::vector<uint8_t> other_type = build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3, 1, 0x0C);
+    std::vector<uint8_t> truncated = build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3);
+    truncated.pop_back();
+    for (const std::vector<uint8_t>* packet : {&query, &other_destination, &other_type, &truncated}) {
+        hal::test::inject_ddp_packet(packet->data(), packet->size());
+    }
+    network_poll();
+
+    TEST_ASSERT_TRUE(hal::test::get_cpu_low_power());
+    TEST_ASSERT_TRUE(idle_is_active());
+
+    std::vector<uint8_t> valid = build_ddp(FLAGS_V1 | FLAG_PUSH, 0, rgb, 3);
+    hal::test::inject_ddp_packet(valid.data(), valid.size());
+    network_poll();
+
+    TEST_ASSERT_FALSE(hal::test::get_cpu_low_power());
+    TEST_ASSERT_FALSE(idle_is_active());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ddp_single_packet_push);
+    RUN_TEST(test_ddp_push_only_packet);
+    RUN_TEST(test_ddp_partial_update_keeps_pixels);
+    RUN_TEST(test_ddp_pending_frame_not_torn);
+    RUN_TEST(test_ddp_timecode_header);
+    RUN_TEST(test_ddp_ignores_unsupported);
+    RUN_TEST(test_ddp_accepts_rgb_data_types);
+    RUN_TEST(test_ddp_out_of_range_clipped);
+    RUN_TEST(test_ddp_source_switch);
+    RUN_TEST(test_ddp_via_network_poll);
+    RUN_TEST(test_ddp_only_valid_packets_wake);
+
+    return UNITY_END();
+}
@@ -0,0 +1,236 @@
+#include <unity.h>
+#include "../../src/hal/hal.h"
+#include "../../src/idle.h"
+#include "../../src/led_driver.h"
+#include "../../src/network.h"
+#include "../../src/receiver.h"
+#include "../../src/config_autogen.h"
+#include <cstring>
+
+// Packet header size
+static const size_t HEADER_SIZE = 6;
+
+static void build_packet(uint8_t* buffer, uint16_t session_id, uint32_t frame_id,
+                         uint8_t r, uint8_t g, uint8_t b, int led_count) {
+    buffer[0] = (session_id >> 8) & 0xFF;
+    buffer[1] = session_id & 0xFF;
+    buffer[2] = (frame_id >> 24) & 0xFF;
+    buffer[3] = (frame_id >> 16) & 0xFF;
+    buffer[4] = (frame_id >> 8) & 0xFF;
+    buffer[5] = frame_id & 0xFF;
+
+    for (int i = 0; i < led_count; i++) {
+        buffer[HEADER_SIZE + i * 3 + 0] = r;
+        buffer[HEADER_SIZE + i * 3 + 1] = g;
+        buffer[HEADER_SIZE + i * 3 + 2] = b;
+    }
+}
+
+static void inject_complete_frame(uint16_t session_id, uint32_t frame_id,
+                                  uint8_t r, uint8_t g, uint8_t b) {
+    for (int run = 0; run < RUN_COUNT; run++) {
+        uint8_t buffer[HEADER_SIZE + 800 * 3];
+        build_packet(buffer, session_id, frame_id, r, g, b, LED_COUNT[run]);
+        hal::test::inject_packet(run, buffer, HEADER_SIZE + LED_COUNT[run] * 3);
+    }
+}
+
+// Receive and display one frame, as the main loop does
+static void show_frame(uint16_t session_id, uint32_t frame_id,
+                       uint8_t r, uint8_t g, uint8_t b) {
+    inject_complete_frame(session_id, frame_id, r, g, b);
+    network_poll();
+    const uint8_t* frame = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(frame);
+    driver_show_frame(frame);
+    idle_frame_displayed();
+}
+
+// Poll the idle state machine until the fade completes and the core sleeps
+static void run_until_sleeping() {
+    for (uint32_t t = 0; t <= IDLE_FADE_MS + 100; t += 10) {
+        idle_poll();
+        if (hal::test::get_cpu_low_power()) {
+            return;
+        }
+        hal::test::advance_time(10);
+    }
+}
+
+void setUp(void) {
+    hal::test::reset();
+    driver_init();
+    receiver_init();
+    idle_init();
+}
+
+void tearDown(void) {
+}
+
+// Test: stays active while the silence is shorter than the timeout
+void test_idle_not_entered_before_timeout(void) {
+    show_frame(1, 1, 200, 100, 50);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS - 1);
+    idle_poll();
+
+    TEST_ASSERT_FALSE(idle_is_active());
+    TEST_ASSERT_FALSE(hal::test::get_cpu_low_power());
+    TEST_ASSERT_EQUAL(0, hal::test::get_wait_count());
+}
+
+// Test: packets keep resetting the silence timer
+void test_idle_activity_resets_timeout(void) {
+    show_frame(1, 1, 200, 100, 50);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS - 10);
+    show_frame(1, 2, 200, 100, 50);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS - 10);
+    idle_poll();
+
+    TEST_ASSERT_FALSE(idle_is_active());
+}
+
+// Test: fade scales the last frame down towards black
+void test_idle_fades_last_frame(void) {
+    show_frame(1, 1, 200, 100, 50);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    idle_poll();
+    TEST_ASSERT_TRUE(idle_is_active());
+
+    // Halfway through the fade the frame is roughly half brightness
+    hal::test::advance_time(IDLE_FADE_MS / 2);
+    idle_poll();
+
+    auto led = hal::test::get_led(0, 0);
+    TEST_ASSERT_TRUE(led.r > 80 && led.r < 120);
+    TEST_ASSERT_TRUE(led.g > 40 && led.g < 60);
+    TEST_ASSERT_TRUE(led.b > 20 && led.b < 30);
+
+    // Clock stays at full speed while fading
+    TEST_ASSERT_FALSE(hal::test::get_cpu_low_power());
+}
+
+// Test: a partial frame after the last one shown doesn't leak into the fade
+void test_idle_fade_ignores_trailing_partial_frame(void) {
+    show_frame(1, 1, 200, 200, 200);
+
+    // Stream stops after one packet of the next frame (e.g. the rest was lost);
+    // it reuses the receiver slot the shown frame came from
+    uint8_t buffer[HEADER_SIZE + 800 * 3];
+    build_packet(buffer, 1, 2, 50, 50, 50, LED_COUNT[0]);
+    hal::test::inject_packet(0, buffer, HEADER_SIZE + LED_COUNT[0] * 3);
+    network_poll();
+    if (RUN_COUNT > 1) {
+        TEST_ASSERT_NULL(receiver_get_complete_frame());
+    }
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    idle_poll();
+    hal::test::advance_time(IDLE_FADE_MS / 2);
+    idle_poll();
+
+    // Every run fades from the frame that was actually displayed
+    for (int run = 0; run < RUN_COUNT; run++) {
+        auto led = hal::test::get_led(run, LED_COUNT[run] - 1);
+        TEST_ASSERT_TRUE(led.r > 80 && led.r < 120);
+    }
+}
+
+// Test: after the fade, LEDs are black, clock is lowered and loop sleeps
+void test_idle_sleeps_after_fade(void) {
+    show_frame(1, 1, 200, 100, 50);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    idle_poll();
+    run_until_sleeping();
+
+    TEST_ASSERT_TRUE(hal::test::get_cpu_low_power());
+    for (int i = 0; i < LED_COUNT[0]; i++) {
+        auto led = hal::test::get_led(0, i);
+        TEST_ASSERT_EQUAL(0, led.r);
+        TEST_ASSERT_EQUAL(0, led.g);
+        TEST_ASSERT_EQUAL(0, led.b);
+    }
+
+    // Sleeping loop waits for interrupts instead of busy-polling
+    int shows_before = hal::test::get_show_count();
+    idle_poll();
+    idle_poll();
+    TEST_ASSERT_EQUAL(2, hal::test::get_wait_count());
+    TEST_ASSERT_EQUAL(shows_before, hal::test::get_show_count());
+}
+
+// Test: first packet restores the clock and the first frame records wake latency
+void test_idle_wakes_on_first_packet(void) {
+    show_frame(1, 1, 200, 100, 50);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    idle_poll();
+    run_until_sleeping();
+    TEST_ASSERT_TRUE(hal::test::get_cpu_low_power());
+    TEST_ASSERT_EQUAL(0, idle_get_last_wake_us());
+
+    // Stream resumes; the frame completes 3ms after the waking packet
+    inject_complete_frame(1, 2, 0, 255, 0);
+    network_poll();
+    TEST_ASSERT_FALSE(idle_is_active());
+    TEST_ASSERT_FALSE(hal::test::get_cpu_low_power());
+
+    hal::test::advance_time(3);
+    const uint8_t* frame = receiver_get_complete_frame();
+    TEST_ASSERT_NOT_NULL(frame);
+    driver_show_frame(frame);
+    idle_frame_displayed();
+
+    TEST_ASSERT_EQUAL(3000, idle_get_last_wake_us());
+    TEST_ASSERT_EQUAL(255, hal::test::get_led(0, 0).g);
+}
+
+// Test: wake latency includes restoring the full clock
+void test_idle_wake_latency_includes_clock_switch(void) {
+    show_frame(1, 1, 200, 100, 50);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    idle_poll();
+    run_until_sleeping();
+    TEST_ASSERT_TRUE(hal::test::get_cpu_low_power());
+
+    hal::test::set_clock_switch_ms(2);
+    show_frame(1, 2, 0, 255, 0);
+
+    TEST_ASSERT_EQUAL(2000, idle_get_last_wake_us());
+}
+
+// Test: a packet during the fade cancels it without touching the clock
+void test_idle_packet_during_fade_cancels(void) {
+    show_frame(1, 1, 200, 100, 50);
+
+    hal::test::advance_time(IDLE_TIMEOUT_MS);
+    idle_poll();
+    TEST_ASSERT_TRUE(idle_is_active());
+
+    show_frame(1, 2, 10, 20, 30);
+    TEST_ASSERT_FALSE(idle_is_active());
+    TEST_ASSERT_FALSE(hal::test::get_cpu_low_power());
+
+    // Never slept, so no wake latency is recorded
+    TEST_ASSERT_EQUAL(0, idle_get_last_wake_us());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_idle_not_entered_before_timeout);
+    RUN_TEST(test_idle_activity_resets_timeout);
+    RUN_TEST(test_idle_fades_last_frame);
+    RUN_TEST(test_idle_fade_ignores_trailing_partial_frame);
+    RUN_TEST(test_idle_sleeps_after_fade);
+    RUN_TEST(test_idle_wakes_on_first_packet);
+    RUN_TEST(test_idle_wake_latency_includes_clock_switch);
+    RUN_TEST(test_idle_packet_during_fade_cancels);
+
+    return UNITY_END();
+}
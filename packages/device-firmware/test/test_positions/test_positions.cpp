@@ -0,0 +1,110 @@
+#include <unity.h>
+#include "../../src/hal/hal.h"
+#include "../../src/positions.h"
+#include "../../src/config_autogen.h"
+#include <cstdlib>
+
+void setUp(void) {
+    hal::test::reset();
+}
+
+void tearDown(void) {
+}
+
+// Test: one entry per LED, 6 bytes each
+void test_positions_table_covers_all_leds(void) {
+    int total = 0;
+    for (int run = 0; run < RUN_COUNT; run++) {
+        total += LED_COUNT[run];
+    }
+
+    TEST_ASSERT_EQUAL(total, POSITION_COUNT);
+    TEST_ASSERT_EQUAL(6, sizeof(LedPosition));
+    TEST_ASSERT_EQUAL(total * 6, positions_table_bytes());
+}
+
+// Test: runs index into the concatenated table
+void test_positions_for_run_offsets(void) {
+    const LedPosition* first = positions_for_run(0);
+    TEST_ASSERT_NOT_NULL(first);
+
+    int offset = 0;
+    for (int run = 0; run < RUN_COUNT; run++) {
+        TEST_ASSERT_TRUE(positions_for_run(run) == first + offset);
+        offset += LED_COUNT[run];
+    }
+
+    TEST_ASSERT_NULL(positions_for_run(-1));
+    TEST_ASSERT_NULL(positions_for_run(RUN_COUNT));
+}
+
+// Test: out-of-range lookups return zero
+void test_positions_get_out_of_range(void) {
+    LedPosition position = positions_get(0, LED_COUNT[0]);
+    TEST_ASSERT_EQUAL(0, position.x);
+    TEST_ASSERT_EQUAL(0, position.y);
+    TEST_ASSERT_EQUAL(0, position.z);
+}
+
+// Test: fixed point maps onto the layout bounds
+void test_positions_to_units_spans_bounds(void) {
+    for (int axis = 0; axis < 3; axis++) {
+        TEST_ASSERT_TRUE(positions_to_units(0, axis) == POSITION_MIN[axis]);
+        float max = positions_to_units(65535, axis);
+        TEST_ASSERT_TRUE(max > POSITION_MAX[axis] - 0.0001f && max < POSITION_MAX[axis] + 0.0001f);
+    }
+}
+
+// Test: LEDs in a v1 (straight line) section step evenly from its x0 end to its x1 end
+void test_positions_follow_section_direction(void) {
+    const SectionInfo& section = SECTIONS[0];
+    TEST_ASSERT_GREATER_THAN(2, section.count);
+
+    // Walk from the x0 end (last physical LED for reversed sections)
+    auto from_x0 = [&](int i) {
+        int index = section.direction < 0 ? section.start + section.count - 1 - i
+                                          : section.start + i;
+        return (int)positions_get(section.run, index).x;
+    };
+
+    // Sections without coordinates collapse to a point (every step is 0)
+    int first_step = from_x0(1) - from_x0(0);
+    for (int i = 1; i < section.count; i++) {
+        int step = from_x0(i) - from_x0(i - 1);
+        // Same direction, equal spacing within rounding
+        TEST_ASSERT_TRUE(abs(step - first_step) <= 1);
+    }
+}
+
+// Test: bounds are tight - some LED sits on each end of every non-flat axis
+void test_positions_bounds_are_tight(void) {
+    const uint16_t* values = reinterpret_cast<const uint16_t*>(positions_for_run(0));
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (POSITION_MAX[axis] == POSITION_MIN[axis]) {
+            continue;
+        }
+        bool has_min = false;
+        bool has_max = false;
+        for (int i = 0; i < POSITION_COUNT; i++) {
+            uint16_t value = values[i * 3 + axis];
+            has_min = has_min || value == 0;
+            has_max = has_max || value == 65535;
+        }
+        TEST_ASSERT_TRUE(has_min);
+        TEST_ASSERT_TRUE(has_max);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_positions_table_covers_all_leds);
+    RUN_TEST(test_positions_for_run_offsets);
+    RUN_TEST(test_positions_get_out_of_range);
+    RUN_TEST(test_positions_to_units_spans_bounds);
+    RUN_TEST(test_positions_follow_section_direction);
+    RUN_TEST(test_positions_bounds_are_tight);
+
+    return UNITY_END();
+}